@@ -0,0 +1,45 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Monotonic microsecond clock on Timer1.
+ */
+#include "clock.h"
+#include "config.h"
+
+#if _XTAL_FREQ / 4 / 4 != 1000000
+#error "Timer1 must count microseconds; adjust the prescaler in the HAL"
+#endif
+
+// Overflows of the timer: the high 16 bits of the time. Written only by
+// the interrupt.
+static volatile uint16_t g_high = 0;
+
+
+void clock_init(void) {
+    g_high = 0;
+    HAL_CLOCK_OPEN();
+}
+
+
+void clock_isr(void) {
+    ++g_high;
+}
+
+
+uint32_t clock_now(void) {
+    uint16_t high = 0;
+    uint16_t low = 0;
+
+    // The high half takes two reads on the PIC18; read it again if the
+    // interrupt changed it meanwhile. With interrupts off, an overflow may
+    // be waiting to be counted: a low half read after it has wrapped.
+    do {
+        high = g_high;
+        low = HAL_CLOCK_READ();
+    } while (high != g_high);
+    if (HAL_CLOCK_OVERFLOW() && low < 0x8000) {
+        ++high;
+    }
+    return ((uint32_t) high << 16) | low;
+}
@@ -0,0 +1,44 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Monotonic clock: Timer1 counts microseconds (Fosc / 4, prescaled 1:4),
+ * and its overflow interrupt extends the count to 32 bits, which wrap
+ * after about 71 minutes. Differences of clock readings are right across
+ * wrap, for intervals shorter than that.
+ *
+ * clock_now16() is the low 16 bits alone, straight from the timer: cheap
+ * enough to stamp every byte in the receive interrupt, and good for
+ * intervals up to 65 ms.
+ */
+#ifndef CLOCK_H_INCLUDED_
+#define CLOCK_H_INCLUDED_
+
+#include <stdint.h>
+#include "hal.h"
+
+// Clock counts per second.
+#define CLOCK_HZ 1000000UL
+
+// Clock counts in a number of milliseconds.
+#define CLOCK_MS(ms) ((uint32_t) (ms) * (CLOCK_HZ / 1000))
+
+/**
+ * Start the clock from zero, and enable its overflow interrupt.
+ */
+void clock_init(void);
+
+/**
+ * Count an overflow of the timer; called from the interrupt handler.
+ */
+void clock_isr(void);
+
+/**
+ * Return the time, in microseconds.
+ */
+uint32_t clock_now(void);
+
+// Return the low 16 bits of the time. Safe in an interrupt handler.
+#define clock_now16() ((uint16_t) HAL_CLOCK_READ())
+
+#endif  // CLOCK_H_INCLUDED_
@@ -11,4 +11,25 @@
 //#define _XTAL_FREQ 8000000
 #define _XTAL_FREQ 16000000
 
+// Frequency of the clock on the CLK inputs of the 8254 counters. The pitch
+// tables (pitch_tables.c) are generated for this value.
+#define INTEL8254_CLOCK_HZ 2000000
+
+// Intel 8254s on the bus (1 to 4), and the chip select decoder output
+// that each is wired to, in timer order. The host build simulates a full
+// bus (see host/Makefile-host.mk.)
+#ifndef INTEL8254_CHIPS
+#define INTEL8254_CHIPS 1
+#endif
+#define INTEL8254_CHIP_SELECTS { 0, 1, 2, 3 }
+
+// MCP4822 DACs on the SPI port (1 to 3), each with its own chip select;
+// the host build simulates two.
+#ifndef DAC_CHIPS
+#define DAC_CHIPS 1
+#endif
+
+// Rate of the control tick (the timer interrupt that paces glide.)
+#define TICK_HZ 1000
+
 #endif  // CONFIG_H_INCLUDED_
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Interrupt-driven MCP4822 driver with per-channel coalescing.
+ */
+#include "dac.h"
+#include "hal.h"
+
+#if DAC_CHIPS < 1 || DAC_CHIPS > 3
+#error "DAC_CHIPS must be 1 to 3"
+#endif
+
+// Top four bits of a frame: the channel (B in bit 15), 1x gain (bit 13)
+// and SHDN (bit 12), active.
+#define FRAME_CHANNEL_B 0x80
+#define FRAME_ACTIVE    0x30
+
+#define NO_CHANNEL 0xff
+
+// Transfer in progress: the channel, and the byte that goes next.
+#define SEND_IDLE 0
+#define SEND_LSB  1   // The MSB is shifting out; the LSB follows.
+#define SEND_END  2   // The LSB is shifting out; then CS rises.
+
+// Code each channel was last sent (or is being sent), and the code waiting
+// for it while it is queued.
+static uint16_t g_sent[DAC_CHANNELS];
+static uint16_t g_waiting[DAC_CHANNELS];
+static unsigned char g_queued[DAC_CHANNELS];
+
+// Channels queued, in order; a channel appears once at most, so the queue
+// holds every channel at once.
+static unsigned char g_queue[DAC_CHANNELS];
+static unsigned char g_queue_head = 0;
+static unsigned char g_queue_count = 0;
+
+static unsigned char g_channel = NO_CHANNEL;
+static unsigned char g_state = SEND_IDLE;
+static unsigned char g_lsb = 0;
+
+
+// Take the next channel off the queue and start its frame.
+static void start_next(void) {
+    const unsigned char channel = g_queue[g_queue_head];
+    g_queue_head = (g_queue_head + 1 == DAC_CHANNELS) ? 0 : g_queue_head + 1;
+    --g_queue_count;
+    g_queued[channel] = 0;
+
+    const uint16_t code = g_waiting[channel];
+    g_sent[channel] = code;
+    g_channel = channel;
+    g_lsb = (unsigned char) (code & 0xff);
+    g_state = SEND_LSB;
+    HAL_DAC_CS(channel >> 1, 0);
+    HAL_SPI_SEND((unsigned char) (code >> 8) | FRAME_ACTIVE |
+                 ((channel & 1) ? FRAME_CHANNEL_B : 0));
+}
+
+
+status_t dac_init() {
+    HAL_SPI_OPEN();
+    g_queue_head = 0;
+    g_queue_count = 0;
+    g_channel = NO_CHANNEL;
+    g_state = SEND_IDLE;
+    for (unsigned char channel = 0; channel < DAC_CHANNELS; ++channel) {
+        g_sent[channel] = 0xffff;
+        g_queued[channel] = 0;
+    }
+    HAL_SPI_IRQ_ENABLE();
+
+    // Start every channel from a known code.
+    for (unsigned char channel = 0; channel < DAC_CHANNELS; ++channel) {
+        dac_write(channel, 0);
+    }
+    return 0;
+}
+
+
+void dac_write(unsigned char channel, uint16_t code) {
+    if (channel >= DAC_CHANNELS) {
+        return;
+    }
+    code &= DAC_CODE_MAX;
+
+    // A channel already queued sends only its latest code.
+    if (g_queued[channel]) {
+        g_waiting[channel] = code;
+        return;
+    }
+    if (code == g_sent[channel]) {
+        return;
+    }
+
+    g_waiting[channel] = code;
+    g_queued[channel] = 1;
+    unsigned char tail = g_queue_head + g_queue_count;
+    if (tail >= DAC_CHANNELS) {
+        tail -= DAC_CHANNELS;
+    }
+    g_queue[tail] = channel;
+    ++g_queue_count;
+    if (g_state == SEND_IDLE) {
+        start_next();
+    }
+}
+
+
+void dac_spi_isr() {
+    switch (g_state) {
+        case SEND_LSB:
+            g_state = SEND_END;
+            HAL_SPI_SEND(g_lsb);
+            break;
+
+        case SEND_END:
+            // The frame is complete: latch it, and start the next.
+            HAL_DAC_CS(g_channel >> 1, 1);
+            g_channel = NO_CHANNEL;
+            g_state = SEND_IDLE;
+            if (g_queue_count) {
+                start_next();
+            }
+            break;
+    }
+}
+
+
+unsigned char dac_busy() {
+    return g_state != SEND_IDLE;
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Driver for the MCP4822 DACs (DAC_CHIPS in config.h) on the SPI port.
+ * Writes never wait for the SPI: each is queued, and the SSP interrupt
+ * shifts out one byte after another, a 16-bit frame per code.
+ *
+ * Channels are numbered across the DACs: 2n is channel A of DAC n and
+ * 2n + 1 channel B. The MCP4822 has no serial output to chain through, so
+ * each DAC has its own chip select on the shared clock and data lines.
+ *
+ * Writes are coalesced per channel: a channel is queued at most once, and
+ * a newer code for it replaces the one waiting, so the queue can never
+ * fill, and the DACs are never more than one frame per channel behind. A
+ * code that a channel already has (or is about to have) is not sent.
+ */
+#ifndef DAC_H_INCLUDED_
+#define DAC_H_INCLUDED_
+
+#include <stdint.h>
+#include "config.h"
+#include "status.h"
+
+// Number of DAC channels.
+#define DAC_CHANNELS (2 * DAC_CHIPS)
+
+// Largest code (12 bits.)
+#define DAC_CODE_MAX 0x0fff
+
+/**
+ * Open the SPI port and enable its interrupt. Every channel is then sent
+ * zero.
+ */
+status_t dac_init();
+
+/**
+ * Queue a code for a channel. Call from the high-priority interrupt, or
+ * with interrupts disabled.
+ *
+ * @param channel DAC channel, 0 to DAC_CHANNELS - 1.
+ * @param code Output code, 0 to DAC_CODE_MAX.
+ */
+void dac_write(unsigned char channel, uint16_t code);
+
+/**
+ * Send the next byte; called from the interrupt handler when the SSP has
+ * finished shifting out the last.
+ */
+void dac_spi_isr();
+
+/**
+ * Return nonzero while a frame is being sent or waits to be.
+ */
+unsigned char dac_busy();
+
+#endif  // DAC_H_INCLUDED_
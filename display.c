@@ -1,80 +1,271 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Shadow framebuffer and incremental refresh for the character LCD.
+ */
 #include "display.h"
-#include <xc.h>
-#include <plib/adc.h>
-#include <plib/xlcd.h>
-#include <plib/delays.h>
 #include "config.h"
+#include "hal.h"
 
+// Instructions (HD44780 data sheet, table 6.)
+#define LCD_CLEAR           0x01
+#define LCD_ENTRY_INCREMENT 0x06
+#define LCD_DISPLAY_OFF     0x08
+#define LCD_DISPLAY_ON      0x0c    // Cursor and blink off.
+#define LCD_FUNCTION_4BIT   0x28    // Four bits, two lines, 5x8 dots.
+#define LCD_SET_DDRAM       0x80
 
-void DelayFor18TCY(void) {
-    // This implementation assumes a 16mhz CPU clock.
-    Nop(); Nop(); Nop(); Nop();
-    Nop(); Nop(); Nop(); Nop();
-    Nop(); Nop(); Nop(); Nop();
-    Nop(); Nop();
+// DDRAM address of the start of each row.
+#define ROW_ADDRESS(row) ((row) ? 0x40 : 0x00)
 
-    Nop(); Nop(); Nop(); Nop();
-    Nop(); Nop(); Nop(); Nop();
-    Nop(); Nop(); Nop(); Nop();
-    Nop(); Nop();
+// An address the LCD is never left at, so that the next character sends
+// a set address first.
+#define NO_ADDRESS 0xff
 
-    return;
+#define NO_CELL 0xff
+
+// Power-on initialization by instruction (data sheet, figure 24): three
+// function sets in 8-bit mode, which work whatever state the LCD was left
+// in, then 4-bit mode. Each step is a single nibble or a whole
+// instruction, and the tick in which the next is sent: the next tick is at
+// least the last 50 us of this one later (see below), the one after that
+// a tick more.
+typedef struct init_step {
+    unsigned char value;
+    unsigned char nibble;
+    unsigned char wait;
+} init_step_t;
+
+static const init_step_t INIT_STEPS[] = {
+    { 0x3, 1, 6 },                  // Over 4.1 ms.
+    { 0x3, 1, 2 },                  // Over 100 us.
+    { 0x3, 1, 1 },
+    { 0x2, 1, 1 },                  // 4-bit mode.
+    { LCD_FUNCTION_4BIT, 0, 1 },
+    { LCD_DISPLAY_OFF, 0, 1 },
+    { LCD_CLEAR, 0, 3 },            // 1.52 ms.
+    { LCD_ENTRY_INCREMENT, 0, 1 }
+};
+
+#define INIT_STEP_COUNT (sizeof(INIT_STEPS) / sizeof(INIT_STEPS[0]))
+
+// Ticks from power-on before the LCD accepts anything (over 40 ms.)
+#define POWER_ON_TICKS ((unsigned char) (50UL * TICK_HZ / 1000))
+
+// The tick timer counts 16 Tcy at a time (see HAL_TICK_ELAPSED().) Nothing
+// is sent in the last 50 us of a tick, so however soon after the next tick
+// display_service() is called again, the LCD has had the 37 us that an
+// instruction takes to execute.
+#define TICK_COUNTS ((unsigned char) (_XTAL_FREQ / 4 / 16 / TICK_HZ))
+#define LATE_COUNTS ((unsigned char) (_XTAL_FREQ / 4 / 16 / 20000))
+
+// Driver state.
+#define STATE_CLOSED 0
+#define STATE_INIT   1
+#define STATE_READY  2
+
+static unsigned char g_state = STATE_CLOSED;
+static unsigned char g_step = 0;
+static unsigned char g_wait = 0;
+
+// The framebuffer, the cells that differ from the screen, and how many.
+static char g_frame[DISPLAY_CELLS];
+static unsigned char g_dirty[DISPLAY_CELLS / 8];
+static unsigned char g_dirty_count = 0;
+
+// The write position, and the LCD's address counter.
+static unsigned char g_cursor = 0;
+static unsigned char g_address = NO_ADDRESS;
+
+// The display on or off command, if one is to be sent.
+static unsigned char g_control = 0;
+
+
+// Strobe four bits into the LCD. E must stay high for at least 450 ns,
+// two Tcy at 16 MHz.
+static void write_nibble(unsigned char nibble) {
+    HAL_LCD_NIBBLE(nibble & 0x0f);
+    HAL_LCD_E(1);
+    HAL_NOP();
+    HAL_NOP();
+    HAL_LCD_E(0);
 }
 
-void DelayPORXLCD(void) {
-    Delay1KTCYx(30);
+// Send an instruction (rs 0) or a character (rs 1), high nibble first.
+static void write_byte(unsigned char rs, unsigned char byte) {
+    HAL_LCD_RS(rs);
+    write_nibble(byte >> 4);
+    write_nibble(byte);
 }
 
-void DelayXLCD(void) {
-    Delay1KTCYx(10);
+// Set a cell of the framebuffer, marking it dirty if it changes.
+static void put_cell(unsigned char cell, char c) {
+    if (g_frame[cell] == c) {
+        return;
+    }
+    g_frame[cell] = c;
+    const unsigned char bit = 1 << (cell & 7);
+    if (!(g_dirty[cell >> 3] & bit)) {
+        g_dirty[cell >> 3] |= bit;
+        ++g_dirty_count;
+    }
+}
+
+// Find the next dirty cell at or after 'from', wrapping, a byte of the
+// bitmap at a time where it is clean.
+static unsigned char next_dirty(unsigned char from) {
+    unsigned char cell = from;
+    for (unsigned char n = 0; n < DISPLAY_CELLS; ) {
+        const unsigned char bits = g_dirty[cell >> 3];
+        if (!bits) {
+            const unsigned char skip = 8 - (cell & 7);
+            n += skip;
+            cell = (cell + skip) & (DISPLAY_CELLS - 1);
+            continue;
+        }
+        if (bits & (1 << (cell & 7))) {
+            return cell;
+        }
+        ++n;
+        cell = (cell + 1) & (DISPLAY_CELLS - 1);
+    }
+    return NO_CELL;
 }
 
+// DDRAM address of a cell.
+static unsigned char cell_address(unsigned char cell) {
+    return ROW_ADDRESS(cell / DISPLAY_COLS) + (cell % DISPLAY_COLS);
+}
+
+// Cell at a DDRAM address; the first for none.
+static unsigned char address_cell(unsigned char address) {
+    if (address == NO_ADDRESS) {
+        return 0;
+    }
+    return (address & 0x40) ? DISPLAY_COLS + (address & 0x0f) :
+                              address & 0x0f;
+}
+
+
 void display_open(void) {
-    // TODO(tdial): Make sure I'm setting the right options here.
-    OpenXLCD(FOUR_BIT & LINES_5X7);
+    HAL_LCD_INIT();
+    g_state = STATE_INIT;
+    g_step = 0;
+    g_wait = POWER_ON_TICKS;
+    g_address = NO_ADDRESS;
+    g_control = LCD_DISPLAY_ON;
+
+    // The LCD is cleared during initialization, so the framebuffer starts
+    // blank and clean.
+    for (unsigned char cell = 0; cell < DISPLAY_CELLS; ++cell) {
+        g_frame[cell] = ' ';
+    }
+    for (unsigned char i = 0; i < sizeof(g_dirty); ++i) {
+        g_dirty[i] = 0;
+    }
+    g_dirty_count = 0;
+    g_cursor = 0;
 }
 
+
 void display_clear(void) {
-    while (BusyXLCD());
-    WriteCmdXLCD(0x01);
+    for (unsigned char cell = 0; cell < DISPLAY_CELLS; ++cell) {
+        put_cell(cell, ' ');
+    }
+    g_cursor = 0;
 }
 
+
 void display_move(unsigned char row, unsigned char col) {
-    // TODO(tdial): I don't think this is right. Need to read the data sheet
-    // on the device.
-    const char addr = (0x40 * row) + col;
-    while (BusyXLCD());
-    SetDDRamAddr(addr);
+    if (row >= DISPLAY_ROWS || col >= DISPLAY_COLS) {
+        return;
+    }
+    g_cursor = row * DISPLAY_COLS + col;
 }
 
+
 void display_enable(void) {
-    while (BusyXLCD());
-    WriteCmdXLCD(DON);
+    g_control = LCD_DISPLAY_ON;
 }
 
+
 void display_disable(void) {
-    while (BusyXLCD());
-    WriteCmdXLCD(DOFF);
+    g_control = LCD_DISPLAY_OFF;
 }
 
+
 void display_write_string(const char* str) {
-    while (BusyXLCD());
-    putrsXLCD(str);
+    const unsigned char row_end =
+        (g_cursor / DISPLAY_COLS + 1) * DISPLAY_COLS;
+    while (*str && g_cursor < row_end) {
+        put_cell(g_cursor++, *str++);
+    }
+    if (g_cursor == DISPLAY_CELLS) {
+        g_cursor = 0;
+    }
 }
 
-void display_test(void) {
-    unsigned char pos = 0;
-    for (;;) {
-        display_clear();
-        
-        while (BusyXLCD());
-        SetDDRamAddr(pos);
-        ++pos;
-        
-        while (BusyXLCD());
-        putsXLCD("synthesizer");
-      __delay_ms(100);
-      __delay_ms(100);
-      __delay_ms(100);
+
+void display_service(void) {
+    if (g_state == STATE_CLOSED ||
+        HAL_TICK_ELAPSED() >= TICK_COUNTS - LATE_COUNTS) {
+        return;
+    }
+    if (g_wait) {
+        --g_wait;
+        return;
     }
+
+    switch (g_state) {
+        case STATE_INIT: {
+            const init_step_t* step = &INIT_STEPS[g_step];
+            if (step->nibble) {
+                HAL_LCD_RS(0);
+                write_nibble(step->value);
+            } else {
+                write_byte(0, step->value);
+            }
+            g_wait = step->wait - 1;
+            if (++g_step == INIT_STEP_COUNT) {
+                g_state = STATE_READY;
+            }
+            break;
+        }
+
+        case STATE_READY: {
+            if (g_control) {
+                write_byte(0, g_control);
+                g_control = 0;
+                break;
+            }
+            if (!g_dirty_count) {
+                break;
+            }
+
+            // Carry on from the LCD's address where that cell is dirty, so
+            // a run of cells costs a single set address.
+            const unsigned char cell = next_dirty(address_cell(g_address));
+            const unsigned char address = cell_address(cell);
+            if (address != g_address) {
+                write_byte(0, LCD_SET_DDRAM | address);
+                g_address = address;
+                break;
+            }
+            write_byte(1, g_frame[cell]);
+            g_dirty[cell >> 3] &= ~(1 << (cell & 7));
+            --g_dirty_count;
+
+            // The address counter runs on past the end of a row, where no
+            // cell is.
+            g_address = ((cell + 1) % DISPLAY_COLS) ? address + 1 :
+                                                      NO_ADDRESS;
+            break;
+        }
+    }
+}
+
+
+unsigned char display_dirty(void) {
+    return g_dirty_count != 0 || g_control != 0;
 }
@@ -1,18 +1,45 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * 16x2 character LCD (HD44780, 4-bit, write only.) Writes go to a shadow
+ * framebuffer in RAM, and mark the cells that differ from the screen as
+ * dirty. display_service(), called once per control tick, sends the LCD at
+ * most one command or character (two nibbles), so it never waits on the
+ * busy flag: a tick is longer than any instruction but clear, which gets
+ * an extra tick. A full redraw takes about 40 ticks; only the cells that
+ * changed are sent.
+ */
 #ifndef DISPLAY_H_INCLUDED_
 #define DISPLAY_H_INCLUDED_
 
+#define DISPLAY_ROWS 2
+#define DISPLAY_COLS 16
+#define DISPLAY_CELLS (DISPLAY_ROWS * DISPLAY_COLS)
 
+// Start the power-on initialization of the LCD, which display_service()
+// carries out over the next 50 or so ticks, and blank the framebuffer.
 void display_open(void);
 
+// Blank the framebuffer.
 void display_clear(void);
 
+// Move the write position.
 void display_move(unsigned char row, unsigned char col);
 
+// Turn the display on or off (from the next command sent.)
 void display_enable(void);
-
 void display_disable(void);
 
+// Write a string to the framebuffer at the write position, up to the end
+// of the row.
 void display_write_string(const char* str);
 
-void display_test(void);
-#endif  // DISPLAY_H_INCLUDED_
\ No newline at end of file
+// Send the LCD the next command or character, if any; called once per
+// control tick.
+void display_service(void);
+
+// Return nonzero while the screen differs from the framebuffer.
+unsigned char display_dirty(void);
+
+#endif  // DISPLAY_H_INCLUDED_
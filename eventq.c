@@ -0,0 +1,260 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Queue of decoded MIDI messages, from the receive interrupt to the main
+ * loop.
+ */
+#include "eventq.h"
+#include "hal.h"
+#include "ioport.h"
+
+#define EVENTQ_MASK (EVENTQ_SIZE - 1)
+
+// Controllers from data increment (96) on count, or act, each time they
+// are sent; those below set a value. Of those, 64 to 69 are switches.
+#define CC_FIRST_UNCOALESCED 96
+#define CC_FIRST_SWITCH      64
+#define CC_LAST_SWITCH       69
+
+// Continuous data handed out by eventq_peek() at a time.
+#define EVENTQ_CONTROL_BATCH 4
+
+#if (EVENTQ_SIZE & EVENTQ_MASK) || (EVENTQ_SIZE > 128)
+#error "EVENTQ_SIZE must be a power of two no larger than 128"
+#endif
+
+
+/**
+ * The queue is two rings, one per class, each as the ioport ring: the
+ * indices are free-running single bytes, masked when used; the interrupt
+ * only writes head and the main loop only writes tail and claim. Each
+ * event's arrival time is kept alongside it.
+ *
+ * The claim is the end of the events the main loop has been handed (tail
+ * <= claim <= head); only those after it may be coalesced into.
+ */
+typedef struct ring {
+    midi_event_t events[EVENTQ_SIZE];
+    uint16_t times[EVENTQ_SIZE];
+    unsigned char head;
+    unsigned char tail;
+    unsigned char claim;
+} ring_t;
+
+#define RING_NOTES    0
+#define RING_CONTROLS 1
+
+static volatile ring_t g_rings[2];
+
+// Nonzero to queue continuous data behind the notes; zero for a single
+// queue in arrival order.
+static volatile unsigned char g_priority = 1;
+
+// The ring of the events last handed out by eventq_peek().
+static unsigned char g_peeked = RING_NOTES;
+
+// The interrupt's decoder; the events are dispatched by the main loop.
+static midi_decoder_t g_decoder;
+
+// Queue statistics; updated by the interrupt.
+static volatile eventq_stats_t g_stats;
+
+
+static void clear_stats(void) {
+    g_stats.events = 0;
+    g_stats.coalesced = 0;
+    g_stats.dropped = 0;
+    g_stats.ahead = 0;
+    g_stats.high_water = 0;
+}
+
+
+// Nonzero for a message that only sets a value, which a later one with the
+// same key replaces. The switches (sustain, portamento, legato and the
+// like) change state: a press and release must both be dispatched.
+static unsigned char continuous(const midi_event_t* evt) {
+    switch (evt->type) {
+        case EVT_CHAN_POLY_AFTERTOUCH:
+        case EVT_CHAN_AFTERTOUCH:
+        case EVT_CHAN_PITCH_BEND:
+            return 1;
+        case EVT_CHAN_CONTROL_CHANGE:
+            if (evt->data1 >= CC_FIRST_SWITCH &&
+                evt->data1 <= CC_LAST_SWITCH) {
+                return 0;
+            }
+            return evt->data1 < CC_FIRST_UNCOALESCED;
+    }
+    return 0;
+}
+
+// Nonzero for continuous data, which goes behind the notes: a continuous
+// message but for poly aftertouch, which applies to one note and so stays
+// in order with it.
+static unsigned char control_class(const midi_event_t* evt) {
+    if (evt->type == EVT_CHAN_POLY_AFTERTOUCH) {
+        return 0;
+    }
+    return continuous(evt);
+}
+
+// Nonzero if two continuous messages set the same value: the same type
+// and channel, and the same controller or key where there is one.
+static unsigned char same_key(const volatile midi_event_t* a,
+                              const midi_event_t* b) {
+    if (a->type != b->type || a->channel != b->channel) {
+        return 0;
+    }
+    return b->type == EVT_CHAN_PITCH_BEND ||
+           b->type == EVT_CHAN_AFTERTOUCH ||
+           a->data1 == b->data1;
+}
+
+// Queue a decoded event, with its arrival time.
+static void push(const midi_event_t* evt, uint16_t time) {
+    const unsigned char r =
+        (g_priority && control_class(evt)) ? RING_CONTROLS : RING_NOTES;
+    volatile ring_t* const ring = &g_rings[r];
+    const unsigned char head = ring->head;
+
+    // A new value for the last event queued, which the main loop has not
+    // taken yet, replaces it, even in a full ring.
+    if (head != ring->claim && continuous(evt)) {
+        const unsigned char last = (unsigned char) (head - 1) & EVENTQ_MASK;
+        if (same_key(&ring->events[last], evt)) {
+            ring->events[last].data1 = evt->data1;
+            ring->events[last].data2 = evt->data2;
+            ring->times[last] = time;
+            ++g_stats.coalesced;
+            return;
+        }
+    }
+
+    const unsigned char used = (unsigned char) (head - ring->tail);
+    if (used >= EVENTQ_SIZE) {
+        // The main loop has fallen too far behind; drop the event.
+        ++g_stats.dropped;
+        return;
+    }
+    if (r == RING_NOTES &&
+        g_rings[RING_CONTROLS].head != g_rings[RING_CONTROLS].tail) {
+        ++g_stats.ahead;
+    }
+
+    ring->events[head & EVENTQ_MASK] = *evt;
+    ring->times[head & EVENTQ_MASK] = time;
+    ring->head = head + 1;
+    if (used >= g_stats.high_water) {
+        g_stats.high_water = used + 1;
+    }
+}
+
+
+void eventq_init(void) {
+    for (unsigned char r = 0; r < 2; ++r) {
+        g_rings[r].head = 0;
+        g_rings[r].tail = 0;
+        g_rings[r].claim = 0;
+    }
+    g_priority = 1;
+    g_peeked = RING_NOTES;
+    midi_decoder_init(&g_decoder);
+    clear_stats();
+}
+
+
+void eventq_set_priority(unsigned char on) {
+    g_priority = on;
+}
+
+
+void eventq_rx_isr(void) {
+    const unsigned char* data = 0;
+    const uint16_t* times = 0;
+    unsigned char count = 0;
+    while ((count = ioport_peek_timed(&data, &times)) != 0) {
+        for (unsigned char i = 0; i < count; ) {
+            // System exclusive payload goes straight to its handler, in
+            // chunks, from the ring.
+            const unsigned char run = (unsigned char)
+                midi_decoder_sysex_span(&g_decoder, data + i, count - i);
+            if (run) {
+                i += run;
+                continue;
+            }
+            midi_event_t evt;
+            if (midi_decoder_decode_byte(&g_decoder, data[i], &evt)) {
+                ++g_stats.events;
+                push(&evt, times[i]);
+            }
+            ++i;
+        }
+        ioport_consume(count);
+    }
+}
+
+
+void eventq_register_sysex_handler(midi_sysex_callback_t cb) {
+    HAL_USART_RX_IRQ_DISABLE();
+    midi_decoder_register_sysex_handler(&g_decoder, cb);
+    HAL_USART_RX_IRQ_ENABLE();
+}
+
+
+unsigned char eventq_available(void) {
+    return (unsigned char) (g_rings[RING_NOTES].head -
+                            g_rings[RING_NOTES].tail) +
+           (unsigned char) (g_rings[RING_CONTROLS].head -
+                            g_rings[RING_CONTROLS].tail);
+}
+
+
+unsigned char eventq_peek(const midi_event_t** events,
+                          const uint16_t** times) {
+    // The notes first; continuous data a few events at a time, so that a
+    // note that comes in meanwhile waits for no more than those.
+    unsigned char r = RING_NOTES;
+    unsigned char most = EVENTQ_SIZE;
+    if (g_rings[RING_NOTES].head == g_rings[RING_NOTES].tail) {
+        r = RING_CONTROLS;
+        most = EVENTQ_CONTROL_BATCH;
+    }
+    volatile ring_t* const ring = &g_rings[r];
+    const unsigned char tail = ring->tail;
+    const unsigned char used = (unsigned char) (ring->head - tail);
+    const unsigned char to_end = EVENTQ_SIZE - (tail & EVENTQ_MASK);
+    unsigned char count = (used < to_end) ? used : to_end;
+    if (count > most) {
+        count = most;
+    }
+
+    // Once claimed, the interrupt no longer writes the events handed out,
+    // so they can be handed out without the volatile qualifier until they
+    // are consumed. One coalesced into before the claim is read with its
+    // new value.
+    ring->claim = tail + count;
+    g_peeked = r;
+    *events = (const midi_event_t*) &ring->events[tail & EVENTQ_MASK];
+    *times = (const uint16_t*) &ring->times[tail & EVENTQ_MASK];
+    return count;
+}
+
+
+void eventq_consume(unsigned char count) {
+    g_rings[g_peeked].tail += count;
+}
+
+
+void eventq_get_stats(eventq_stats_t* stats) {
+    HAL_USART_RX_IRQ_DISABLE();
+    *stats = g_stats;
+    HAL_USART_RX_IRQ_ENABLE();
+}
+
+
+void eventq_reset_stats(void) {
+    HAL_USART_RX_IRQ_DISABLE();
+    clear_stats();
+    HAL_USART_RX_IRQ_ENABLE();
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Queue of decoded MIDI messages, from the receive interrupt to the main
+ * loop. eventq_rx_isr(), called from the high-priority interrupt just after
+ * ioport_rx_isr(), runs the bytes waiting in the ioport ring through a MIDI
+ * decoder of its own and queues each complete message as a 4-byte
+ * midi_event_t, with the arrival time of the byte that completed it. A
+ * message is decoded in the interrupt its last byte arrives in, however
+ * busy the main loop is; the main loop takes the events in batches and
+ * dispatches them to the MIDI handlers (see midi_dispatch().)
+ *
+ * Like the ioport ring, the queue has a single producer (the interrupt)
+ * and a single consumer (the main loop), each of which owns one index, so
+ * no locking is needed on the PIC18.
+ *
+ * System exclusive payload is not queued: it goes, in chunks, to the
+ * handler registered with eventq_register_sysex_handler(), which is called
+ * from the interrupt as the bytes are decoded, or is discarded if there is
+ * none. The handler must be brief, and must not call the MIDI or queue
+ * functions; the chunks point into the ioport ring.
+ *
+ * A message that only sets a value (pitch bend, aftertouch, or a controller
+ * below 96 but for the switches, 64 to 69, such as sustain) replaces the
+ * one queued just before it if that one sets the same value (the same type
+ * and channel, and controller or key) and the main loop has not yet taken
+ * it: a flood of bend or mod wheel is dispatched at the rate the main loop
+ * runs, with the latest value. Every other message is queued, so notes
+ * keep their exact order, and a quick tap of the sustain pedal is not
+ * lost. The queue stops coalescing into the events eventq_peek() has
+ * handed out.
+ *
+ * Under a backlog, the notes go first: continuous data (bend, channel
+ * aftertouch and the controllers that set a value) is queued apart, and
+ * handed out only when no other event is waiting. Poly aftertouch belongs
+ * to a note, so it is queued with the notes. Each class keeps its order,
+ * so a note's on, pressure and off, and the values of a controller, arrive
+ * as sent; only a value sent just before a note may be applied just after
+ * it.
+ */
+#ifndef EVENTQ_H_INCLUDED_
+#define EVENTQ_H_INCLUDED_
+
+#include <stdint.h>
+#include "midi.h"
+
+// Size of the queue of each class, in events. Must be a power of two no
+// larger than 128.
+// At 31250 baud, 32 events of two bytes (with running status) absorb
+// about 20 ms of main loop stall, as much as the 64-byte ioport ring did.
+#ifndef EVENTQ_SIZE
+#define EVENTQ_SIZE 32
+#endif
+
+/**
+ * Queue statistics, for sizing the queue.
+ */
+typedef struct eventq_stats {
+    unsigned long events;       // Messages decoded.
+    unsigned long coalesced;    // Replaced by a later value before dispatch.
+    unsigned long dropped;      // Discarded because the queue was full.
+    unsigned long ahead;        // Queued ahead of continuous data waiting.
+    unsigned char high_water;   // Most events ever waiting in the queue.
+} eventq_stats_t;
+
+/**
+ * Empty the queue, reset its decoder (discarding system exclusive payload)
+ * and clear the statistics. Call before the receive interrupt is enabled.
+ */
+void eventq_init(void);
+
+/**
+ * Turn priority for the notes on (the default) or off; off, events are
+ * handed out in the order they arrived. Takes effect for events queued
+ * after the call.
+ *
+ * @param on Nonzero for priority.
+ */
+void eventq_set_priority(unsigned char on);
+
+/**
+ * Decode the bytes waiting in the ioport ring and queue the complete
+ * messages; a message that finds the queue full is dropped. Must be called
+ * from the high-priority interrupt vector, after ioport_rx_isr().
+ */
+void eventq_rx_isr(void);
+
+/**
+ * Register the handler for system exclusive payload received on the queued
+ * input (see midi_sysex_callback_t); it is called from the receive
+ * interrupt. Pass a NULL pointer to discard the payload, which is the
+ * default. Call after eventq_init().
+ *
+ * @param cb Function to invoke with each chunk of payload.
+ */
+void eventq_register_sysex_handler(midi_sysex_callback_t cb);
+
+/**
+ * Return the number of events waiting.
+ */
+unsigned char eventq_available(void);
+
+/**
+ * Return a run of waiting events of one class, contiguous in the queue,
+ * with their arrival times, without consuming them; call eventq_consume()
+ * once they have been handled. The notes come first, as many as are
+ * contiguous; continuous data a few events at a time, so that a note
+ * queued meanwhile is soon handed out.
+ *
+ * @param events Receives the first event waiting.
+ * @param times Receives the arrival time of the first event.
+ * @return Number of events in the run; zero if none are waiting.
+ */
+unsigned char eventq_peek(const midi_event_t** events,
+                          const uint16_t** times);
+
+/**
+ * Release events returned by eventq_peek() back to the queue.
+ *
+ * @param count Number of events handled; at most the count peeked.
+ */
+void eventq_consume(unsigned char count);
+
+/**
+ * Copy the queue statistics.
+ *
+ * @param stats Receives the statistics.
+ */
+void eventq_get_stats(eventq_stats_t* stats);
+
+/**
+ * Clear the queue statistics.
+ */
+void eventq_reset_stats(void);
+
+#endif  // EVENTQ_H_INCLUDED_
@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Portamento (glide) at a fixed rate per control tick.
+ */
+#include "glide.h"
+
+
+void glide_init(glide_t* glide) {
+    glide->mode = GLIDE_MODE_TIME;
+    glide->ticks = 0;
+    glide_jump(glide, PITCH_MAX);
+}
+
+
+void glide_set_time(glide_t* glide, unsigned char mode, uint16_t ticks) {
+    glide->mode = mode;
+    glide->ticks = ticks;
+}
+
+
+void glide_jump(glide_t* glide, pitch_t pitch) {
+    glide->position = (uint32_t) pitch << 8;
+    glide->target = pitch;
+    glide->step = 0;
+}
+
+
+void glide_to(glide_t* glide, pitch_t pitch) {
+    const pitch_t current = glide_pitch(glide);
+    if (glide->ticks == 0 || pitch == current) {
+        glide_jump(glide, pitch);
+        return;
+    }
+
+    // The speed is fixed for the whole glide: in time mode, the interval
+    // over the glide time, and in rate mode, an octave over the octave
+    // time. Either way, at least 1/256 step per tick.
+    uint32_t span = PITCH_STEPS_PER_OCTAVE;
+    if (glide->mode == GLIDE_MODE_TIME) {
+        span = (pitch > current) ? (pitch - current) : (current - pitch);
+    }
+    uint32_t step = (span << 8) / glide->ticks;
+    if (step == 0) {
+        step = 1;
+    } else if (step > 0xffff) {
+        step = 0xffff;
+    }
+    glide->step = (uint16_t) step;
+    glide->target = pitch;
+}
+
+
+unsigned char glide_advance(glide_t* glide, unsigned char ticks) {
+    const uint32_t target = (uint32_t) glide->target << 8;
+    if (glide->position == target) {
+        return 0;
+    }
+
+    // Move by the step for each tick, stopping at the target.
+    const uint32_t delta = (uint32_t) glide->step * ticks;
+    const pitch_t before = glide_pitch(glide);
+    if (glide->position < target) {
+        glide->position = (target - glide->position > delta) ?
+                          glide->position + delta : target;
+    } else {
+        glide->position = (glide->position - target > delta) ?
+                          glide->position - delta : target;
+    }
+    return glide_pitch(glide) != before;
+}
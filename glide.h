@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Portamento (glide): a pitch that moves toward a target at a fixed rate
+ * per tick of the control-rate timer (TICK_HZ in config.h.) Because it is
+ * advanced by elapsed ticks rather than by passes of the main loop, the
+ * glide takes the same time however busy the loop is.
+ *
+ * Two modes set the speed:
+ *
+ *   GLIDE_MODE_TIME  - Every glide takes the same time, whatever the
+ *                      interval.
+ *   GLIDE_MODE_RATE  - Every glide moves at the same speed, so a wide
+ *                      interval takes longer than a narrow one.
+ */
+#ifndef GLIDE_H_INCLUDED_
+#define GLIDE_H_INCLUDED_
+
+#include <stdint.h>
+#include "pitch.h"
+
+typedef enum glide_mode {
+    GLIDE_MODE_TIME = 0,
+    GLIDE_MODE_RATE = 1
+} glide_mode_t;
+
+typedef struct glide {
+    uint32_t position;      // Current pitch, in 1/256 pitch steps.
+    pitch_t target;         // Pitch the glide is moving toward.
+    uint16_t step;          // Speed of this glide, 1/256 steps per tick.
+    uint16_t ticks;         // Glide time, or time per octave (see below.)
+    unsigned char mode;     // GLIDE_MODE_xxx
+} glide_t;
+
+/**
+ * Initialize a glide: time mode, with a time of zero (no glide), at rest
+ * at PITCH_MAX.
+ */
+void glide_init(glide_t* glide);
+
+/**
+ * Set the mode and speed of subsequent glides. A time of zero disables
+ * glide; glide_to() then jumps.
+ *
+ * @param glide Glide to configure.
+ * @param mode GLIDE_MODE_TIME or GLIDE_MODE_RATE.
+ * @param ticks In time mode, the ticks that every glide takes; in rate
+ *              mode, the ticks taken to glide an octave.
+ */
+void glide_set_time(glide_t* glide, unsigned char mode, uint16_t ticks);
+
+/**
+ * Move to a pitch at once, abandoning any glide in progress.
+ */
+void glide_jump(glide_t* glide, pitch_t pitch);
+
+/**
+ * Start a glide from the current pitch to a new one. In time mode this
+ * costs a division, once per glide; glide_advance() costs none.
+ */
+void glide_to(glide_t* glide, pitch_t pitch);
+
+/**
+ * Advance the glide by a number of elapsed ticks.
+ *
+ * @return Nonzero if the current pitch changed.
+ */
+unsigned char glide_advance(glide_t* glide, unsigned char ticks);
+
+// Return the current pitch of a glide.
+#define glide_pitch(glide) ((pitch_t) ((glide)->position >> 8))
+
+#endif  // GLIDE_H_INCLUDED_
@@ -0,0 +1,48 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Hardware abstraction layer. The portable modules (MIDI, IOPORT, 8254, the
+ * synth application) never touch PIC registers directly; instead they use
+ * the HAL_xxx macros defined by one of the backends below:
+ *
+ *   hal_pic.h        - PIC18F4620 backend; macros expand to register access,
+ *                      so there is no call overhead on the target.
+ *   host/hal_host.h  - Linux backend; macros call into a simulation of the
+ *                      board that also counts instruction cycles spent on
+ *                      I/O, so the hot paths can be measured with gcc.
+ *
+ * The host backend is selected by defining HAL_HOST (the 'host' make target
+ * does this.)
+ *
+ * Groups of macros provided by each backend:
+ *
+ *   GPIO   HAL_GPIO_INIT(), HAL_LED_ERROR(v), HAL_LED_NOTE(v)
+ *   USART  HAL_USART_OPEN(spbrg, brgh), HAL_USART_RX_READY(),
+ *          HAL_USART_RX_READ(), HAL_USART_RX_FERR(), HAL_USART_RX_OERR(),
+ *          HAL_USART_RX_RESTART(), HAL_USART_RX_IRQ_ENABLE(),
+ *          HAL_USART_RX_IRQ_DISABLE()
+ *   SPI    HAL_SPI_OPEN(), HAL_SPI_SEND(b), HAL_SPI_DONE(), HAL_SPI_CLEAR(),
+ *          HAL_SPI_IRQ_ENABLE(), HAL_DAC_CS(n, v)
+ *   8254   HAL_8254_BUS_INIT(), HAL_8254_DATA(b), HAL_8254_DATA_IN(),
+ *          HAL_8254_DATA_OUT(), HAL_8254_READ(), HAL_8254_A0(v),
+ *          HAL_8254_A1(v), HAL_8254_CS(v), HAL_8254_CHIP(n),
+ *          HAL_8254_WR(v), HAL_8254_RD(v), HAL_8254_WAIT()
+ *   LCD    HAL_LCD_INIT(), HAL_LCD_NIBBLE(n), HAL_LCD_RS(v), HAL_LCD_E(v)
+ *   TICK   HAL_TICK_OPEN(), HAL_TICK_PENDING(), HAL_TICK_CLEAR(),
+ *          HAL_TICK_ELAPSED()
+ *   CLOCK  HAL_CLOCK_OPEN(), HAL_CLOCK_READ(), HAL_CLOCK_OVERFLOW(),
+ *          HAL_CLOCK_CLEAR()
+ *   IRQ    HAL_IRQ_ENABLE(), HAL_IRQ_DISABLE()
+ *   Misc   HAL_NOP(), HAL_DELAY_MS(ms)
+ */
+#ifndef HAL_H_INCLUDED_
+#define HAL_H_INCLUDED_
+
+#ifdef HAL_HOST
+#include "host/hal_host.h"
+#else
+#include "hal_pic.h"
+#endif
+
+#endif  // HAL_H_INCLUDED_
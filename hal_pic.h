@@ -0,0 +1,233 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * PIC18F4620 backend for the hardware abstraction layer (see hal.h.) Every
+ * macro here expands directly to register access so that using the HAL
+ * costs nothing on the target.
+ */
+#ifndef HAL_PIC_H_INCLUDED_
+#define HAL_PIC_H_INCLUDED_
+
+#include <xc.h>
+#include <plib/spi.h>
+#include "config.h"
+
+
+/*
+ * GPIO
+ */
+
+// Configure I/O pins used in the system, set them to their initial state.
+// The 8254 strobes (WR on RD7, chip select on RD6 and RD on RD2) are
+// latched inactive, high, before PORTD becomes an output, so that no 8254
+// drives the data bus against PORTB or latches it.
+#define HAL_GPIO_INIT() do {                       \
+        ADCON1 = 0x0f;  /* All pins digital */     \
+        LATD = 0b11000100;                         \
+        TRISB = 0;                                 \
+        PORTB = 0;                                 \
+        TRISC = 0;                                 \
+        PORTC = 0;                                 \
+        TRISD = 0;                                 \
+        PORTCbits.RC3 = 0;                         \
+    } while (0)
+
+#define HAL_LED_ERROR(v)  (PORTDbits.RD0 = (v))
+#define HAL_LED_NOTE(v)   (PORTDbits.RD1 = (v))
+
+
+/*
+ * USART
+ */
+
+// Configure the USART for asynchronous receive/transmit with the given
+// baud rate generator value and high speed (BRGH) setting.
+#define HAL_USART_OPEN(spbrg, brgh) do {                              \
+        BRGH = (brgh);                                                \
+        SPBRG = (spbrg);                                              \
+        SYNC = 0;    /* Asynchronous mode (clear sync bit to zero.) */ \
+        SPEN = 1;    /* Enable serial communication. */                \
+        TRISC7 = 1;  /* Configure as RX pin (serial data receive) */   \
+        TRISC6 = 1;  /* Configure as TX pin (serial data transmit) */  \
+        CREN = 1;    /* Enable reception */                            \
+        TXEN = 1;    /* Enable transmission */                         \
+    } while (0)
+
+#define HAL_USART_RX_READY()  (RCIF)
+#define HAL_USART_RX_READ()   (RCREG)
+
+// Receive errors. FERR applies to the byte at the top of the FIFO and must
+// be read before RCREG. OERR stops reception until CREN is cycled.
+#define HAL_USART_RX_FERR()   (RCSTAbits.FERR)
+#define HAL_USART_RX_OERR()   (RCSTAbits.OERR)
+#define HAL_USART_RX_RESTART() do { \
+        CREN = 0;                   \
+        CREN = 1;                   \
+    } while (0)
+
+// Route the receive interrupt to the high-priority vector and enable it.
+#define HAL_USART_RX_IRQ_ENABLE() do { \
+        IPEN = 1;                      \
+        RCIP = 1;                      \
+        RCIE = 1;                      \
+    } while (0)
+
+#define HAL_USART_RX_IRQ_DISABLE()  (RCIE = 0)
+
+
+/*
+ * SPI (MCP4822 DACs; the chip select of DAC n is on A(n + 1), for up to
+ * three.) A byte is sent by writing SSPBUF; SSPIF is raised, on the
+ * high-priority vector, when it has been shifted out.
+ */
+
+#define HAL_SPI_OPEN() do {                      \
+        ADCON1 = 0x0f;  /* All pins digital */   \
+        TRISA = 0;                               \
+        TRISCbits.TRISC5 = 0;                    \
+        TRISCbits.TRISC3 = 0;                    \
+        TRISCbits.TRISC4 = 1;                    \
+        LATA |= 0b00001110;                      \
+        OpenSPI(SPI_FOSC_4, MODE_00, SMPEND);    \
+    } while (0)
+
+#define HAL_SPI_SEND(b)   (SSPBUF = (b))
+#define HAL_SPI_DONE()    (SSPIF)
+
+// Clear the interrupt flag, and read SSPBUF to clear BF.
+#define HAL_SPI_CLEAR() do { \
+        SSPIF = 0;           \
+        (void) SSPBUF;       \
+    } while (0)
+
+#define HAL_SPI_IRQ_ENABLE() do { \
+        IPEN = 1;                 \
+        SSPIP = 1;                \
+        SSPIF = 0;                \
+        SSPIE = 1;                \
+    } while (0)
+
+#define HAL_DAC_CS(n, v) do {                        \
+        if (v) {                                     \
+            LATA |= (unsigned char) (2 << (n));      \
+        } else {                                     \
+            LATA &= (unsigned char) ~(2 << (n));     \
+        }                                            \
+    } while (0)
+
+
+/*
+ * Intel 8254 bus. The data lines are on PORTB; the address, chip select and
+ * read and write strobes are on PORTD. PORTB is an output except while an
+ * 8254 is read. With more than one 8254, the chip select on RD6 enables a
+ * 2-to-4 decoder whose inputs, the chip address, are on RE1:RE0. Those
+ * are analog inputs at reset, so HAL_GPIO_INIT() makes them digital; the
+ * address is written through LATE, never read back from the pins.
+ */
+
+#define HAL_8254_BUS_INIT() do { \
+        TRISB = 0;               \
+        PORTB = 0;               \
+        TRISD = 0;               \
+        PORTDbits.RD2 = 1;       \
+        TRISE = 0;               \
+        LATE = 0;                \
+    } while (0)
+
+#define HAL_8254_DATA(b)     (PORTB = (b))
+#define HAL_8254_DATA_IN()   (TRISB = 0xff)
+#define HAL_8254_DATA_OUT()  (TRISB = 0)
+#define HAL_8254_READ()      (PORTB)
+#define HAL_8254_A0(v)    (PORTDbits.RD4 = (v))
+#define HAL_8254_A1(v)    (PORTDbits.RD5 = (v))
+#define HAL_8254_CS(v)    (PORTDbits.RD6 = (v))
+#define HAL_8254_CHIP(n)  (LATE = (unsigned char) ((LATE & ~3) | ((n) & 3)))
+#define HAL_8254_WR(v)    (PORTDbits.RD7 = (v))
+#define HAL_8254_RD(v)    (PORTDbits.RD2 = (v))
+
+// Time the 8254 needs between the edges of a strobe. A Tcy is 250 ns at
+// 16 MHz. The 8254 needs WR low for at least 150 ns, with the data set up
+// 120 ns before it rises, and drives the data bus at most 120 ns after RD
+// falls. Edges one instruction apart leave WR low for 250 ns, but would
+// read PORTB too soon after RD falls; one more Tcy covers both. The
+// instructions that set up the next strobe give the 200 ns the 8254 needs
+// to recover between them.
+#define HAL_8254_WAIT() Nop()
+
+
+/*
+ * Character LCD (HD44780, 4-bit, write only; R/W is tied low.) D7:D4 share
+ * RB3:RB0 with the 8254 data bus. Sharing is safe because the LCD ignores
+ * the bus but for the falling edge of E, on RC1, which the driver strobes
+ * only with its own nibble out; the 8254s see nothing without a WR or RD
+ * strobe. RS is on RC0.
+ */
+
+#define HAL_LCD_INIT() do {            \
+        TRISCbits.TRISC0 = 0;          \
+        TRISCbits.TRISC1 = 0;          \
+        PORTCbits.RC0 = 0;             \
+        PORTCbits.RC1 = 0;             \
+    } while (0)
+
+#define HAL_LCD_NIBBLE(n)  (LATB = (LATB & 0xf0) | (n))
+#define HAL_LCD_RS(v)      (PORTCbits.RC0 = (v))
+#define HAL_LCD_E(v)       (PORTCbits.RC1 = (v))
+
+
+/*
+ * Control tick. Timer2 raises a high-priority interrupt TICK_HZ times a
+ * second: Fosc / 4, prescaled 1:16, over a period of PR2 + 1 counts.
+ */
+
+#define HAL_TICK_OPEN() do {                                        \
+        PR2 = (unsigned char) (_XTAL_FREQ / 4 / 16 / TICK_HZ - 1);  \
+        T2CON = 0b00000110;  /* Postscale 1:1, on, prescale 1:16 */ \
+        IPEN = 1;                                                   \
+        TMR2IP = 1;                                                 \
+        TMR2IF = 0;                                                 \
+        TMR2IE = 1;                                                 \
+    } while (0)
+
+#define HAL_TICK_PENDING()  (TMR2IF)
+#define HAL_TICK_CLEAR()    (TMR2IF = 0)
+
+// Time since the last tick, in units of 16 Tcy: how long the work done
+// since then took.
+#define HAL_TICK_ELAPSED()  (TMR2)
+
+
+/*
+ * Clock. Timer1 counts Fosc / 4 prescaled 1:4, free running, and raises a
+ * high-priority interrupt when it overflows. RD16 latches the high byte
+ * when the low byte is read, so the 16-bit TMR1 reads in one piece.
+ */
+
+#define HAL_CLOCK_OPEN() do {                                          \
+        T1CON = 0b10100000;  /* RD16, prescale 1:4, Fosc / 4, off */   \
+        TMR1H = 0;                                                     \
+        TMR1L = 0;                                                     \
+        TMR1IP = 1;                                                    \
+        TMR1IF = 0;                                                    \
+        TMR1IE = 1;                                                    \
+        TMR1ON = 1;                                                    \
+    } while (0)
+
+#define HAL_CLOCK_READ()      (TMR1)
+#define HAL_CLOCK_OVERFLOW()  (TMR1IF)
+#define HAL_CLOCK_CLEAR()     (TMR1IF = 0)
+
+
+/*
+ * Miscellaneous
+ */
+
+#define HAL_NOP()          Nop()
+#define HAL_DELAY_MS(ms)   __delay_ms(ms)
+
+// Globally enable / disable high-priority interrupts (IPEN is set.)
+#define HAL_IRQ_ENABLE()   (GIEH = 1)
+#define HAL_IRQ_DISABLE()  (GIEH = 0)
+
+#endif  // HAL_PIC_H_INCLUDED_
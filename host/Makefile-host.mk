@@ -0,0 +1,77 @@
+#
+# Native (gcc) build of the portable firmware modules against the simulated
+# board in host/hal_host.c. Invoked from the project Makefile; see the
+# 'host' and 'host-bench' targets there.
+#
+# XC8 treats plain 'char' as unsigned, so the host build does too. It is
+# built for a full bus of four 8254s and for two DACs (see INTEL8254_CHIPS
+# and DAC_CHIPS in config.h.)
+#
+
+CC=gcc
+CFLAGS=-std=gnu99 -O2 -g -Wall -funsigned-char -DHAL_HOST -DINTEL8254_CHIPS=4 -DDAC_CHIPS=2 -I.
+LDLIBS=-pthread
+
+OBJECTDIR=build/host
+DISTDIR=dist/host
+
+# Firmware sources shared with the PIC build (main.c is PIC-only.)
+FIRMWARE_SOURCES=synth.c midi.c ioport.c intel8254.c pitch.c pitch_tables.c \
+                 tuning.c tuning_tables.c glide.c voice.c \
+                 note_stack.c modulation.c dac.c display.c \
+                 sched.c clock.c eventq.c
+
+# Host-only sources. midi_legacy.c is the previous parser, kept for the
+# benchmark comparison.
+HOST_SOURCES=host/hal_host.c host/midi_legacy.c
+
+FIRMWARE_OBJECTS=$(addprefix ${OBJECTDIR}/,$(FIRMWARE_SOURCES:.c=.o) $(HOST_SOURCES:.c=.o))
+
+PROGRAMS=${DISTDIR}/bench
+
+# Sources generated on the host for the configuration in config.h. They are
+# checked in, so that the PIC build does not need a host compiler unless
+# the configuration changes; the project Makefile refreshes them before
+# every build.
+GENERATED_SOURCES=pitch_tables.c tuning_tables.c
+
+# Resident tuning tables, in order; the first is selected at power-up. Each
+# is a Scala scale, optionally followed by a keyboard mapping:
+# scale.scl[:mapping.kbm]
+TUNINGS=tunings/12tet.scl \
+        tunings/just.scl:tunings/just.kbm \
+        tunings/19edo.scl
+
+
+build: ${PROGRAMS}
+
+tables: ${GENERATED_SOURCES}
+
+${DISTDIR}/bench: ${OBJECTDIR}/host/bench.o ${FIRMWARE_OBJECTS}
+	@mkdir -p ${DISTDIR}
+	${CC} ${CFLAGS} -o $@ $^ ${LDLIBS} -lm
+
+${DISTDIR}/gen_pitch_tables: ${OBJECTDIR}/host/gen_pitch_tables.o
+	@mkdir -p ${DISTDIR}
+	${CC} ${CFLAGS} -o $@ $^ -lm
+
+pitch_tables.c: ${DISTDIR}/gen_pitch_tables
+	$< > $@.tmp && mv $@.tmp $@
+
+${DISTDIR}/scl2tuning: ${OBJECTDIR}/host/scl2tuning.o
+	@mkdir -p ${DISTDIR}
+	${CC} ${CFLAGS} -o $@ $^ -lm
+
+tuning_tables.c: ${DISTDIR}/scl2tuning $(subst :, ,${TUNINGS})
+	$< ${TUNINGS} > $@.tmp && mv $@.tmp $@
+
+${OBJECTDIR}/%.o: %.c
+	@mkdir -p $(dir $@)
+	${CC} ${CFLAGS} -MMD -MP -c -o $@ $<
+
+clean:
+	rm -rf ${OBJECTDIR} ${DISTDIR}
+
+-include $(wildcard ${OBJECTDIR}/*.d ${OBJECTDIR}/host/*.d)
+
+.PHONY: build tables clean
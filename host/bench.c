@@ -0,0 +1,2768 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Host benchmarks for the firmware hot paths. Runs the real firmware modules
+ * against the simulated board (hal_host.c) and reports host throughput along
+ * with simulated PIC18 instruction cycles spent on I/O, so that performance
+ * regressions can be caught before flashing a unit.
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "clock.h"
+#include "config.h"
+#include "dac.h"
+#include "display.h"
+#include "eventq.h"
+#include "hal.h"
+#include "intel8254.h"
+#include "ioport.h"
+#include "midi.h"
+#include "midi_legacy.h"
+#include "modulation.h"
+#include "note_stack.h"
+#include "pitch.h"
+#include "sched.h"
+#include "tuning.h"
+#include "synth.h"
+#include "voice.h"
+
+// Size of the synthetic MIDI stream used for throughput measurements.
+#define STREAM_LEN (1 << 20)
+
+// Parallel parsing: number of streams, bytes per stream, worker threads,
+// and the chunk size in which each thread interleaves its streams.
+#define PARALLEL_STREAMS 4096
+#define PARALLEL_STREAM_LEN 1024
+#define PARALLEL_THREADS 8
+#define PARALLEL_CHUNK 16
+
+// Minimum wall-clock time spent on each throughput measurement.
+#define MIN_SECONDS 0.25
+
+// Instruction cycles per byte on the wire at the MIDI rate (10 bits/byte.)
+#define MIDI_TCY_PER_BYTE ((_XTAL_FREQ / 4) / (MIDI_BAUD_RATE / 10))
+
+// Number of bytes replayed at the MIDI rate through the receive path.
+#define RX_REPLAY_LEN 20000
+
+// Duration of a slow main loop pass in the receive replay, which stands in
+// for LCD busy waits and 8254 initialization delays.
+#define RX_SLOW_PASS_MS 10
+
+
+static unsigned char g_stream[STREAM_LEN];
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned long g_rand_state = 1;
+
+static unsigned char rand7(void) {
+    g_rand_state = g_rand_state * 1103515245UL + 12345UL;
+    return (unsigned char) ((g_rand_state >> 16) & 0x7f);
+}
+
+// Fill a buffer with a plausible performance: notes (often using running
+// status), controllers, pitch bend and interleaved timing clocks. Different
+// seeds give different performances.
+static unsigned long make_stream_seeded(unsigned char* buf, unsigned long len,
+                                        unsigned long seed) {
+    unsigned long n = 0;
+    unsigned char status = 0;
+    g_rand_state = seed;
+    while (n + 4 <= len) {
+        const unsigned char r = rand7();
+        unsigned char next = 0;
+        if (r < 64) {
+            next = 0x90;
+        } else if (r < 80) {
+            next = 0x80;
+        } else if (r < 104) {
+            next = 0xb0;
+        } else if (r < 120) {
+            next = 0xe0;
+        } else {
+            buf[n++] = 0xf8;
+            continue;
+        }
+        if (next != status) {
+            status = next;
+            buf[n++] = status;
+        }
+        buf[n++] = rand7();
+        buf[n++] = rand7();
+    }
+    return n;
+}
+
+static unsigned long make_stream(unsigned char* buf, unsigned long len) {
+    return make_stream_seeded(buf, len, 1);
+}
+
+static void report(const char* what, double value, const char* unit) {
+    printf("%-48s %14.1f %s\n", what, value, unit);
+}
+
+// Stands in for the high-priority interrupt vector in main.c.
+static void isr_high(void) {
+    if (HAL_USART_RX_READY()) {
+        ioport_rx_isr();
+        eventq_rx_isr();
+    }
+    if (HAL_TICK_PENDING()) {
+        HAL_TICK_CLEAR();
+        synth_tick_isr();
+    }
+    if (HAL_SPI_DONE()) {
+        HAL_SPI_CLEAR();
+        dac_spi_isr();
+    }
+    if (HAL_CLOCK_OVERFLOW()) {
+        HAL_CLOCK_CLEAR();
+        clock_isr();
+    }
+}
+
+// The receive interrupt alone, with nothing decoding the ring: for the
+// benches of the ring itself, where the main loop reads the bytes.
+static void isr_ring(void) {
+    if (HAL_USART_RX_READY()) {
+        ioport_rx_isr();
+    }
+}
+
+
+// Parser throughput with no application work attached to the events.
+static double parser_ns_per_byte(status_t (*receive)(char),
+                                 unsigned long len) {
+    unsigned long long bytes = 0;
+    const double start = now();
+    double elapsed = 0;
+    do {
+        for (unsigned long i = 0; i < len; ++i) {
+            receive(g_stream[i]);
+        }
+        bytes += len;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    return elapsed * 1e9 / bytes;
+}
+
+static void bench_parser_null(void) {
+    const unsigned long len = make_stream(g_stream, STREAM_LEN);
+
+    midi_init();
+    const double table = parser_ns_per_byte(midi_receive_byte, len);
+    legacy_midi_init();
+    const double legacy = parser_ns_per_byte(legacy_midi_receive_byte, len);
+
+    report("midi_receive_byte(), null handlers", 1e9 / table, "bytes/s");
+    report("  table-driven parser", table, "ns/byte");
+    report("  switch-based parser (previous)", legacy, "ns/byte");
+}
+
+
+/*
+ * Event recording, for checking that two parsers behave identically.
+ */
+
+typedef struct recorded_event {
+    unsigned char evt;
+    unsigned char chan;
+    unsigned char data1;
+    unsigned char data2;
+} recorded_event_t;
+
+#define MAX_RECORDED (STREAM_LEN / 2)
+
+static recorded_event_t g_recorded[MAX_RECORDED];
+static unsigned long g_recorded_count = 0;
+
+static void record(unsigned char evt, char chan, char data1, char data2) {
+    if (g_recorded_count < MAX_RECORDED) {
+        recorded_event_t* r = &g_recorded[g_recorded_count];
+        r->evt = evt;
+        r->chan = chan;
+        r->data1 = data1;
+        r->data2 = data2;
+    }
+    ++g_recorded_count;
+}
+
+#define RECORDER(n) \
+    static void record_##n(char c, char a, char b) { record(n, c, a, b); }
+RECORDER(0) RECORDER(1) RECORDER(2) RECORDER(3) RECORDER(4)
+RECORDER(5) RECORDER(6) RECORDER(7) RECORDER(8) RECORDER(9)
+RECORDER(10) RECORDER(11) RECORDER(12) RECORDER(13) RECORDER(14)
+RECORDER(15) RECORDER(16) RECORDER(17) RECORDER(18)
+
+static const midi_event_callback_t RECORDERS[EVT_MAX] = {
+    record_0, record_1, record_2, record_3, record_4,
+    record_5, record_6, record_7, record_8, record_9,
+    record_10, record_11, record_12, record_13, record_14,
+    record_15, record_16, record_17, record_18
+};
+
+// Run a stream through a parser, recording its events and return codes
+// into 'out' (which must hold MAX_RECORDED entries.)
+static unsigned long record_stream(status_t (*init)(void),
+                                   status_t (*reg)(event_type,
+                                                   midi_event_callback_t),
+                                   status_t (*receive)(char),
+                                   const unsigned char* stream,
+                                   unsigned long len,
+                                   recorded_event_t* out) {
+    init();
+    for (int evt = 0; evt < EVT_MAX; ++evt) {
+        reg((event_type) evt, RECORDERS[evt]);
+    }
+    g_recorded_count = 0;
+    for (unsigned long i = 0; i < len; ++i) {
+        const status_t rc = receive(stream[i]);
+        record(0x80 | (unsigned char) rc, 0, 0, 0);
+    }
+    const unsigned long n = g_recorded_count < MAX_RECORDED ?
+                            g_recorded_count : MAX_RECORDED;
+    if (out != g_recorded) {
+        for (unsigned long i = 0; i < n; ++i) {
+            out[i] = g_recorded[i];
+        }
+    }
+    return n;
+}
+
+// Check that the table-driven parser produces exactly the same events and
+// return codes as the switch-based one, for a performance stream and for
+// random bytes (which exercise stray data bytes and odd status sequences.)
+static int check_parser_equivalence(void) {
+    static recorded_event_t expected[MAX_RECORDED];
+    int errors = 0;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        const unsigned long len = MAX_RECORDED / 3;
+        if (pass == 0) {
+            make_stream(g_stream, len);
+        } else {
+            // System bytes are left out: the old parser let a real-time
+            // byte that arrived mid-message clobber the first data byte,
+            // and ignored system common messages (keeping running status.)
+            g_rand_state = 7;
+            for (unsigned long i = 0; i < len; ++i) {
+                do {
+                    g_rand_state = g_rand_state * 1103515245UL + 12345UL;
+                    g_stream[i] = (unsigned char) (g_rand_state >> 16);
+                } while (g_stream[i] >= 0xf0);
+            }
+            // midi_init() resets the protocol state but legacy_midi_init()
+            // does not, so start from a known status.
+            g_stream[0] = 0x90;
+        }
+        const unsigned long n_legacy =
+            record_stream(legacy_midi_init,
+                          legacy_midi_register_event_handler,
+                          legacy_midi_receive_byte, g_stream, len, expected);
+        const unsigned long n_table =
+            record_stream(midi_init, midi_register_event_handler,
+                          midi_receive_byte, g_stream, len, g_recorded);
+        unsigned long mismatches = (n_legacy != n_table);
+        for (unsigned long i = 0; !mismatches && i < n_table; ++i) {
+            if (g_recorded[i].evt != expected[i].evt ||
+                g_recorded[i].chan != expected[i].chan ||
+                g_recorded[i].data1 != expected[i].data1 ||
+                g_recorded[i].data2 != expected[i].data2) {
+                ++mismatches;
+            }
+        }
+        if (mismatches) {
+            fprintf(stderr, "parser differs from the switch-based parser "
+                    "on the %s stream\n", pass ? "random" : "performance");
+            ++errors;
+        }
+    }
+
+    // A real-time byte in the middle of a message must not disturb it.
+    static const unsigned char interleaved[] = { 0x93, 0x3c, 0xf8, 0x64 };
+    record_stream(midi_init, midi_register_event_handler, midi_receive_byte,
+                  interleaved, sizeof(interleaved), g_recorded);
+    const recorded_event_t* clock = &g_recorded[2];
+    const recorded_event_t* note = &g_recorded[4];
+    if (clock->evt != EVT_SYS_REALTIME_TIMING_CLOCK ||
+        note->evt != EVT_CHAN_NOTE_ON || note->chan != 3 ||
+        note->data1 != 0x3c || note->data2 != 0x64) {
+        fprintf(stderr, "real-time byte disturbed a channel message\n");
+        ++errors;
+    }
+
+    // An event from outside the parser with no valid type is ignored.
+    static const midi_event_t invalid[] = {
+        { EVT_MAX, 0, 0, 0 }, { 0xff, 0, 0, 0 }
+    };
+    g_recorded_count = 0;
+    midi_dispatch(&invalid[0], 0);
+    midi_dispatch(&invalid[1], 0);
+    if (g_recorded_count != 0) {
+        fprintf(stderr, "event of no valid type dispatched\n");
+        ++errors;
+    }
+    return errors;
+}
+
+
+// System exclusive chunks, as delivered to the sysex handler.
+typedef struct recorded_chunk {
+    const uint8_t* data;
+    size_t len;
+    unsigned char flags;
+    unsigned char first;
+} recorded_chunk_t;
+
+#define MAX_CHUNKS 16
+
+static recorded_chunk_t g_chunks[MAX_CHUNKS];
+static unsigned long g_chunk_count = 0;
+static unsigned long g_sysex_bytes = 0;
+static unsigned long g_sysex_sum = 0;
+static unsigned long g_sysex_messages = 0;
+
+static void record_sysex(const uint8_t* data, size_t len,
+                         unsigned char flags) {
+    if (g_chunk_count < MAX_CHUNKS) {
+        recorded_chunk_t* c = &g_chunks[g_chunk_count];
+        c->data = data;
+        c->len = len;
+        c->flags = flags;
+        c->first = len ? data[0] : 0;
+    }
+    ++g_chunk_count;
+}
+
+// Sums the payload, for the dump benchmark.
+static void sum_sysex(const uint8_t* data, size_t len, unsigned char flags) {
+    for (size_t i = 0; i < len; ++i) {
+        g_sysex_sum += data[i];
+    }
+    g_sysex_bytes += len;
+    g_sysex_messages += (flags & MIDI_SYSEX_END) ? 1 : 0;
+}
+
+static int expect_event(unsigned long i, unsigned char evt, char chan,
+                        char data1, char data2) {
+    const recorded_event_t* r = &g_recorded[i];
+    return i < g_recorded_count && r->evt == evt && r->chan == chan &&
+           r->data1 == data1 && r->data2 == data2;
+}
+
+static int expect_chunk(unsigned long i, const uint8_t* data, size_t len,
+                        unsigned char flags) {
+    const recorded_chunk_t* c = &g_chunks[i];
+    return i < g_chunk_count && c->data == data && c->len == len &&
+           c->flags == flags;
+}
+
+// System common messages: data bytes, cancelled running status, and SysEx
+// payload handed over in place (or a byte at a time by midi_receive_byte.)
+static int check_system_common(void) {
+    static const unsigned char common[] = {
+        0x90, 0x3c, 0x64,   // Note on
+        0xf2, 0x10, 0x20,   // Song position
+        0x3c, 0x00,         // No running status after system common
+        0xf6,               // Tune request
+        0xf1, 0x35,         // MTC quarter frame
+        0xf3, 0x05, 0x22,   // Song select, then a stray data byte
+        0xf4, 0x11,         // Undefined status, data ignored
+        0x92, 0x40, 0x7f    // Note on
+    };
+    static const unsigned char sysex[] = {
+        0xf0, 0x7e, 0x01, 0x02, 0xf8, 0x03, 0xf7,   // Clock inside SysEx
+        0xf0, 0x01, 0x02, 0x93, 0x3c, 0x64,         // Cut short by a note
+        0xf0, 0xf7                                  // Empty
+    };
+    int errors = 0;
+
+    // The return code of each byte is recorded too; skip those.
+    midi_init();
+    for (int evt = 0; evt < EVT_MAX; ++evt) {
+        midi_register_event_handler((event_type) evt, RECORDERS[evt]);
+    }
+    g_recorded_count = 0;
+    midi_receive_span(common, sizeof(common));
+    if (g_recorded_count != 6 ||
+        !expect_event(0, EVT_CHAN_NOTE_ON, 0, 0x3c, 0x64) ||
+        !expect_event(1, EVT_SYS_COMMON_SONG_POSITION, 0, 0x10, 0x20) ||
+        !expect_event(2, EVT_SYS_COMMON_TUNE_REQUEST, 0, 0, 0) ||
+        !expect_event(3, EVT_SYS_COMMON_MTC_QUARTER_FRAME, 0, 0x35, 0) ||
+        !expect_event(4, EVT_SYS_COMMON_SONG_SELECT, 0, 0x05, 0) ||
+        !expect_event(5, EVT_CHAN_NOTE_ON, 2, 0x40, 0x7f)) {
+        fprintf(stderr, "system common messages decoded incorrectly\n");
+        ++errors;
+    }
+
+    midi_register_sysex_handler(record_sysex);
+    g_recorded_count = 0;
+    g_chunk_count = 0;
+    midi_receive_span(sysex, sizeof(sysex));
+    if (g_chunk_count != 6 ||
+        !expect_chunk(0, sysex + 1, 3, MIDI_SYSEX_START) ||
+        !expect_chunk(1, sysex + 5, 1, 0) ||
+        !expect_chunk(2, NULL, 0, MIDI_SYSEX_END) ||
+        !expect_chunk(3, sysex + 8, 2, MIDI_SYSEX_START) ||
+        !expect_chunk(4, NULL, 0, MIDI_SYSEX_END | MIDI_SYSEX_ABORTED) ||
+        !expect_chunk(5, NULL, 0, MIDI_SYSEX_START | MIDI_SYSEX_END) ||
+        g_recorded_count != 2 ||
+        !expect_event(0, EVT_SYS_REALTIME_TIMING_CLOCK, 0, 0, 0) ||
+        !expect_event(1, EVT_CHAN_NOTE_ON, 3, 0x3c, 0x64)) {
+        fprintf(stderr, "SysEx chunks delivered incorrectly\n");
+        ++errors;
+    }
+
+    // Byte at a time: the same payload, one chunk per data byte.
+    midi_reset();
+    g_chunk_count = 0;
+    for (size_t i = 0; i < 7; ++i) {
+        midi_receive_byte(sysex[i]);
+    }
+    if (g_chunk_count != 5 || g_chunks[0].flags != MIDI_SYSEX_START ||
+        g_chunks[0].first != 0x7e || g_chunks[2].first != 0x02 ||
+        g_chunks[3].first != 0x03 || g_chunks[4].flags != MIDI_SYSEX_END) {
+        fprintf(stderr, "SysEx from midi_receive_byte() incorrect\n");
+        ++errors;
+    }
+    return errors;
+}
+
+
+// A stream of large SysEx dumps: payload throughput through the receive
+// ring in ring-sized spans, and the RAM it would take to stage instead.
+static int bench_sysex_dump(void) {
+    const unsigned long dump = 32768;
+    unsigned long len = 0;
+    unsigned long messages = 0;
+    unsigned long sum = 0;
+    unsigned long long bytes = 0;
+    int errors = 0;
+
+    g_rand_state = 3;
+    while (len + dump + 2 <= STREAM_LEN) {
+        g_stream[len++] = 0xf0;
+        for (unsigned long i = 0; i < dump; ++i) {
+            g_stream[len] = rand7();
+            sum += g_stream[len++];
+        }
+        g_stream[len++] = 0xf7;
+        ++messages;
+    }
+
+    midi_init();
+    midi_register_sysex_handler(sum_sysex);
+    g_sysex_bytes = 0;
+    g_sysex_sum = 0;
+    g_sysex_messages = 0;
+    for (unsigned long i = 0; i < len; i += IOPORT_RX_RING_SIZE) {
+        const unsigned long chunk = (len - i < IOPORT_RX_RING_SIZE) ?
+                                    len - i : IOPORT_RX_RING_SIZE;
+        midi_receive_span(g_stream + i, chunk);
+    }
+    if (g_sysex_messages != messages || g_sysex_bytes != messages * dump ||
+        g_sysex_sum != sum) {
+        fprintf(stderr, "SysEx dump payload lost or corrupted\n");
+        ++errors;
+    }
+
+    const double start = now();
+    double elapsed = 0;
+    do {
+        for (unsigned long i = 0; i < len; i += IOPORT_RX_RING_SIZE) {
+            const unsigned long chunk = (len - i < IOPORT_RX_RING_SIZE) ?
+                                        len - i : IOPORT_RX_RING_SIZE;
+            midi_receive_span(g_stream + i, chunk);
+        }
+        bytes += len;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    midi_init();
+    midi_register_sysex_handler(sum_sysex);
+    const double per_byte = parser_ns_per_byte(midi_receive_byte, len);
+
+    report("SysEx dump via midi_receive_span()", elapsed * 1e9 / bytes,
+           "ns/byte");
+    report("  via midi_receive_byte()", per_byte, "ns/byte");
+    report("  staging RAM needed per dump (not allocated)", dump, "bytes");
+    return errors;
+}
+
+
+// Throughput of the batch API against the per-byte callback path, and a
+// check that both produce the same events.
+static int bench_parser_buffer(void) {
+    static midi_event_t events[STREAM_LEN];
+    const unsigned long len = make_stream(g_stream, STREAM_LEN);
+    unsigned long long bytes = 0;
+    unsigned long n = 0;
+    int errors = 0;
+
+    midi_init();
+    const double per_byte = parser_ns_per_byte(midi_receive_byte, len);
+
+    midi_init();
+    double start = now();
+    double elapsed = 0;
+    do {
+        n = midi_receive_buffer(g_stream, len, events, STREAM_LEN);
+        bytes += len;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    const double whole = elapsed * 1e9 / bytes;
+
+    // In ring-sized chunks, as when draining the receive ring.
+    midi_init();
+    bytes = 0;
+    start = now();
+    do {
+        for (unsigned long i = 0; i < len; i += IOPORT_RX_RING_SIZE) {
+            const unsigned long chunk = (len - i < IOPORT_RX_RING_SIZE) ?
+                                        len - i : IOPORT_RX_RING_SIZE;
+            midi_receive_buffer(g_stream + i, chunk, events,
+                                IOPORT_RX_RING_SIZE);
+        }
+        bytes += len;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    const double chunked = elapsed * 1e9 / bytes;
+
+    report("midi_receive_buffer(), whole stream", whole, "ns/byte");
+    report("  in ring-sized chunks", chunked, "ns/byte");
+    report("  midi_receive_byte() with callbacks", per_byte, "ns/byte");
+
+    // The batch decode must match the callback path event for event.
+    midi_init();
+    n = midi_receive_buffer(g_stream, MAX_RECORDED / 3, events, STREAM_LEN);
+    const unsigned long n_cb =
+        record_stream(midi_init, midi_register_event_handler,
+                      midi_receive_byte, g_stream, MAX_RECORDED / 3,
+                      g_recorded);
+    unsigned long k = 0;
+    for (unsigned long i = 0; i < n_cb; ++i) {
+        const recorded_event_t* r = &g_recorded[i];
+        if (r->evt & 0x80) {
+            continue;  // Return code, not an event.
+        }
+        if (k >= n || events[k].type != r->evt ||
+            events[k].channel != r->chan || events[k].data1 != r->data1 ||
+            events[k].data2 != r->data2) {
+            ++errors;
+            break;
+        }
+        ++k;
+    }
+    if (errors || k != n) {
+        fprintf(stderr, "midi_receive_buffer() differs from callbacks\n");
+        errors = 1;
+    }
+    return errors;
+}
+
+
+// Throughput of the whole receive path with the synth's handlers attached.
+static void bench_parser_synth(void) {
+    const unsigned long len = make_stream(g_stream, STREAM_LEN);
+    unsigned long long bytes = 0;
+
+    hal_host_reset();
+    system_init();
+
+    const unsigned long long cycles0 = hal_host_stats()->cycles;
+    const double start = now();
+    double elapsed = 0;
+    do {
+        for (unsigned long i = 0; i < len; ++i) {
+            midi_receive_byte(g_stream[i]);
+        }
+        bytes += len;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    const unsigned long long cycles = hal_host_stats()->cycles - cycles0;
+
+    report("midi_receive_byte(), synth handlers", bytes / elapsed, "bytes/s");
+    report("  simulated I/O cycles per byte", (double) cycles / bytes, "Tcy");
+}
+
+
+// Cost of a note-on, from the status byte to the last intel_write_timer().
+static int bench_note_on(void) {
+    static const unsigned char vel = 100;
+    unsigned long long cycles = 0;
+    unsigned long notes = 0;
+    int errors = 0;
+
+    hal_host_reset();
+    system_init();
+
+    const double start = now();
+    for (unsigned char key = 0; key < 128; ++key) {
+        const unsigned long long cycles0 = hal_host_stats()->cycles;
+        midi_receive_byte(0x90);
+        midi_receive_byte(key);
+        midi_receive_byte(vel);
+        cycles += hal_host_stats()->cycles - cycles0;
+        ++notes;
+
+        // The note must have reached counter 0 of the 8254.
+        const hal_host_8254_counter_t* c = hal_host_8254_counter(0);
+        if (c->divisor == 0) {
+            fprintf(stderr, "note %u: counter 0 not loaded\n", key);
+            ++errors;
+        }
+
+        midi_receive_byte(0x80);
+        midi_receive_byte(key);
+        midi_receive_byte(0);
+    }
+    const double elapsed = now() - start;
+
+    report("note-on -> intel_write_timer(), host", elapsed * 1e9 / notes,
+           "ns/note");
+    report("  simulated I/O cycles per note-on", (double) cycles / notes,
+           "Tcy");
+
+    // From power-up on, PORTB and an 8254 must never drive the bus at once.
+    if (hal_host_stats()->bus_contention) {
+        fprintf(stderr, "8254 data bus driven by both ends %lu times\n",
+                hal_host_stats()->bus_contention);
+        ++errors;
+    }
+    return errors;
+}
+
+
+// Bus cost of one counter update through the 8254 driver.
+typedef struct timer_cost {
+    unsigned long tcy;
+    unsigned long writes;
+    unsigned long control_words;
+} timer_cost_t;
+
+static timer_cost_t timer_update(void (*write)(unsigned char, unsigned char,
+                                               unsigned char),
+                                 uint16_t divisor, int* errors) {
+    const hal_host_stats_t before = *hal_host_stats();
+    write(0, divisor & 0xff, divisor >> 8);
+    const hal_host_stats_t* after = hal_host_stats();
+    const timer_cost_t cost = {
+        (unsigned long) (after->cycles - before.cycles),
+        after->bus_writes - before.bus_writes,
+        after->control_words - before.control_words
+    };
+    if (hal_host_8254_counter(0)->divisor != divisor) {
+        fprintf(stderr, "8254: counter 0 holds %u, not %u\n",
+                hal_host_8254_counter(0)->divisor, divisor);
+        ++*errors;
+    }
+    return cost;
+}
+
+static void report_timer_cost(const char* what, timer_cost_t cost) {
+    report(what, cost.tcy, "Tcy");
+    report("  bus writes", cost.writes, "");
+    report("  of which control words", cost.control_words, "");
+}
+
+// Bus cycles per update in intel_write_timer(): a new count in the
+// two-byte format, the same count again (skipped), and a new count in the
+// one-byte format that intel_start_timer() selects for divisors below 256.
+// Only starting a note may write a control word.
+static int bench_timer_writes(void) {
+    int errors = 0;
+
+    hal_host_reset();
+    intel_8254_init();
+    timer_update(intel_write_timer, 7645, &errors);
+
+    const timer_cost_t full = timer_update(intel_write_timer, 7644, &errors);
+    const timer_cost_t same = timer_update(intel_write_timer, 7644, &errors);
+    const timer_cost_t start = timer_update(intel_start_timer, 239, &errors);
+    const timer_cost_t lsb = timer_update(intel_write_timer, 238, &errors);
+    const timer_cost_t back = timer_update(intel_write_timer, 256, &errors);
+
+    report_timer_cost("8254 update, LSB and MSB", full);
+    report_timer_cost("8254 update, divisor unchanged", same);
+    report_timer_cost("8254 update, LSB only", lsb);
+    report_timer_cost("8254 note start, switching to LSB only", start);
+    report_timer_cost("8254 update, LSB only to LSB and MSB", back);
+    if (full.control_words || same.writes || lsb.writes != 1 ||
+        lsb.control_words || start.control_words != 1) {
+        fprintf(stderr, "8254: unexpected bus writes per update\n");
+        ++errors;
+    }
+    return errors;
+}
+
+
+// Batched updates across the chips on the bus: the cost per oscillator of
+// loading new two-byte counts into the counters of the first 1, 2, ... chips,
+// the rest unchanged. Each chip is selected once per update, so the cost
+// per oscillator should not grow as chips are added.
+static int bench_8254_chips(void) {
+    static const unsigned int UPDATES = 100;
+    uint16_t divisors[INTEL8254_COUNTERS];
+    double per_osc[INTEL8254_CHIPS];
+    int errors = 0;
+
+    hal_host_reset();
+    intel_8254_init();
+    for (unsigned char chips = 1; chips <= INTEL8254_CHIPS; ++chips) {
+        for (unsigned char t = 0; t < INTEL8254_COUNTERS; ++t) {
+            divisors[t] = 7000 + t;
+        }
+        intel_write_timers(divisors);
+
+        const unsigned char oscillators = 3 * chips;
+        const hal_host_stats_t before = *hal_host_stats();
+        for (unsigned int i = 0; i < UPDATES; ++i) {
+            for (unsigned char t = 0; t < oscillators; ++t) {
+                divisors[t] ^= 0x100;
+            }
+            intel_write_timers(divisors);
+        }
+        const hal_host_stats_t* after = hal_host_stats();
+        per_osc[chips - 1] = (double) (after->cycles - before.cycles) /
+                             UPDATES / oscillators;
+        if (after->bus_writes - before.bus_writes !=
+            2UL * oscillators * UPDATES ||
+            after->control_words != before.control_words) {
+            fprintf(stderr, "8254 chips: %u chips, unexpected bus writes\n",
+                    chips);
+            ++errors;
+        }
+        for (unsigned char t = 0; t < INTEL8254_COUNTERS; ++t) {
+            if (hal_host_8254_counter(t)->divisor != divisors[t]) {
+                fprintf(stderr, "8254 chips: counter %u holds %u, not %u\n",
+                        t, hal_host_8254_counter(t)->divisor, divisors[t]);
+                ++errors;
+            }
+        }
+
+        char what[64];
+        snprintf(what, sizeof(what),
+                 "8254 batched update, %u chips (%u osc), per osc",
+                 chips, oscillators);
+        report(what, per_osc[chips - 1], "Tcy");
+    }
+    if (per_osc[INTEL8254_CHIPS - 1] > per_osc[0] * 1.05) {
+        fprintf(stderr, "8254 chips: per-oscillator cost grows with chips\n");
+        ++errors;
+    }
+    return errors;
+}
+
+
+// Estimated PIC18 cost of the divisor arithmetic, which the host HAL does not
+// simulate (it only charges I/O.) XC8's 32-bit unsigned divide is a 32-pass
+// shift and subtract loop of about 16 Tcy a pass. The table path is three
+// program memory reads (TBLRD with pointer setup, about 8 Tcy each), two
+// 8 x 8 MULWF products with their moves (about 6 Tcy each) and, at worst, a
+// ten-place 16-bit shift (about 4 Tcy a place.)
+#define EST_TCY_DIVIDE_32   (32 * 16)
+#define EST_TCY_PITCH_TABLE (3 * 8 + 2 * 6 + 10 * 4)
+
+// The previous conversion: a 32-bit division per oscillator write.
+static unsigned int divide_divisor(unsigned long freq) {
+    return (unsigned int) (2000000UL / freq);
+}
+
+// Divisor conversion: the generated tables against the runtime division,
+// and a check of the tables against the exact divisor for every pitch. The
+// note divisor and the fine step are each rounded, so the result may be up
+// to 1.5 counts out (0.04 cents at the bottom of the range). At a note
+// boundary the rounding can leave adjacent pitches one count out of order.
+static int bench_pitch_divisor(void) {
+    static volatile unsigned int sink;
+    unsigned long long conversions = 0;
+    unsigned long off_by = 0;
+    unsigned long non_monotonic = 0;
+    int errors = 0;
+
+    uint16_t previous = 0xffff;
+    for (pitch_t p = PITCH_MIN; p <= PITCH_MAX; ++p) {
+        const double note = (double) p / PITCH_STEPS_PER_SEMITONE;
+        const double hz = 440.0 * pow(2.0, (note - 69.0) / 12.0);
+        const double exact = INTEL8254_CLOCK_HZ / hz;
+        const uint16_t divisor = pitch_to_divisor(p);
+        if (fabs(divisor - exact) > 1.5) {
+            ++off_by;
+        }
+        if (divisor > previous + 1) {
+            ++non_monotonic;
+        }
+        previous = divisor;
+    }
+    if (pitch_to_divisor(0) != pitch_to_divisor(PITCH_MIN)) {
+        ++off_by;
+    }
+    if (off_by || non_monotonic) {
+        fprintf(stderr, "pitch tables: %lu divisors off by more than 1.5 "
+                "counts, %lu out of order\n", off_by, non_monotonic);
+        ++errors;
+    }
+
+    double start = now();
+    double elapsed = 0;
+    do {
+        for (pitch_t p = PITCH_MIN; p <= PITCH_MAX; ++p) {
+            sink = pitch_to_divisor(p);
+        }
+        conversions += PITCH_MAX - PITCH_MIN + 1;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    const double table_ns = elapsed * 1e9 / conversions;
+
+    conversions = 0;
+    start = now();
+    do {
+        for (unsigned long f = 32; f < 12544; ++f) {
+            sink = divide_divisor(f);
+        }
+        conversions += 12544 - 32;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    const double divide_ns = elapsed * 1e9 / conversions;
+
+    (void) sink;
+    report("pitch_to_divisor(), host", table_ns, "ns/call");
+    report("  2000000 / freq (previous), host", divide_ns, "ns/call");
+    report("  estimated PIC18 cycles, tables (worst case)",
+           EST_TCY_PITCH_TABLE, "Tcy");
+    report("  estimated PIC18 cycles, 32-bit divide", EST_TCY_DIVIDE_32,
+           "Tcy");
+    report("  estimated saving per glide step (3 writes)",
+           3 * (EST_TCY_DIVIDE_32 - EST_TCY_PITCH_TABLE), "Tcy");
+    return errors;
+}
+
+
+// Write a byte to a register of the first 8254 directly, behind the
+// driver's back.
+static void raw_8254_write(unsigned char addr, unsigned char byte) {
+    HAL_8254_CHIP(0);
+    HAL_8254_A0(addr & 1);
+    HAL_8254_A1(addr >> 1);
+    HAL_8254_DATA(byte);
+    HAL_8254_WR(0);
+    HAL_8254_WR(1);
+}
+
+// Reading the 8254: the read-back status follows the square wave, and the
+// latched count runs down within the loaded count. A counter that has to
+// leave the one-byte format is reprogrammed just after its output rises,
+// so the control word never forces an edge; for comparison, the same at
+// an arbitrary phase. Last, the spread between the three loads of an
+// update, batched and one counter at a time (as before, when the divisor
+// arithmetic came between the loads.)
+static int check_8254_readback(void) {
+    static const unsigned int TRIALS = 200;
+    unsigned long high = 0;
+    unsigned long samples = 0;
+    unsigned long long status_tcy = 0;
+    unsigned long bad_counts = 0;
+    int errors = 0;
+
+    hal_host_reset();
+    intel_8254_init();
+    intel_write_timer(1, 1000 & 0xff, 1000 >> 8);
+    g_rand_state = 1;
+    for (unsigned int i = 0; i < 1000; ++i) {
+        const unsigned long long cycles0 = hal_host_stats()->cycles;
+        const unsigned char status = intel_read_status(1);
+        status_tcy += hal_host_stats()->cycles - cycles0;
+        const uint16_t count = intel_read_timer(1);
+        if ((status & INTEL_STATUS_OUT) != 0) {
+            ++high;
+        }
+        if (count == 0 || count > 1000 || (count & 1)) {
+            ++bad_counts;
+        }
+        ++samples;
+        hal_host_delay_cycles(rand7() * 7);
+    }
+    report("8254 read-back, OUT high", 100.0 * high / samples, "%");
+    report("  cost of a status read", (double) status_tcy / samples, "Tcy");
+    if (high < samples * 4 / 10 || high > samples * 6 / 10 || bad_counts) {
+        fprintf(stderr, "8254 read-back: OUT high in %lu of %lu samples, "
+                "%lu bad counts\n", high, samples, bad_counts);
+        ++errors;
+    }
+
+    // Leaving the one-byte format, with and without waiting for the edge.
+    unsigned long long synced_tcy = 0;
+    unsigned long synced_clicks = 0;
+    unsigned long raw_clicks = 0;
+    for (unsigned int i = 0; i < TRIALS; ++i) {
+        intel_start_timer(0, 200, 0);
+        hal_host_delay_cycles(1000 + rand7() * 5);
+        const unsigned long before = hal_host_8254_counter(0)->forced_edges;
+        const unsigned long long cycles0 = hal_host_stats()->cycles;
+        intel_write_timer(0, 0x34, 0x12);
+        synced_tcy += hal_host_stats()->cycles - cycles0;
+        synced_clicks += hal_host_8254_counter(0)->forced_edges - before;
+    }
+    for (unsigned int i = 0; i < TRIALS; ++i) {
+        raw_8254_write(3, 0x16);    // Counter 0, LSB only, mode 3
+        raw_8254_write(0, 200);
+        hal_host_delay_cycles(1000 + rand7() * 5);
+        const unsigned long before = hal_host_8254_counter(0)->forced_edges;
+        raw_8254_write(3, 0x36);    // Counter 0, LSB then MSB, mode 3
+        raw_8254_write(0, 0x34);
+        raw_8254_write(0, 0x12);
+        raw_clicks += hal_host_8254_counter(0)->forced_edges - before;
+    }
+    intel_8254_init();
+    report("8254 format change at the output edge, clicks", synced_clicks,
+           "");
+    report("  at an arbitrary phase, clicks", raw_clicks, "");
+    report("  cost of the edge-timed update", (double) synced_tcy / TRIALS,
+           "Tcy");
+    if (synced_clicks) {
+        ++errors;
+    }
+
+    // Spread of the three loads of an update, on the first chip.
+    uint16_t divisors[2][INTEL8254_COUNTERS];
+    for (unsigned char t = 0; t < INTEL8254_COUNTERS; ++t) {
+        divisors[0][t] = (t % 3 == 1) ? 7471 : 7645;
+        divisors[1][t] = divisors[0][t] - 1;
+    }
+    intel_write_timers(divisors[0]);
+    intel_write_timers(divisors[1]);
+    unsigned long long first = ~0ULL;
+    unsigned long long last = 0;
+    for (unsigned char t = 0; t < 3; ++t) {
+        const unsigned long long at = hal_host_8254_counter(t)->loaded_at;
+        first = at < first ? at : first;
+        last = at > last ? at : last;
+    }
+    const double batched = last - first;
+    for (unsigned char t = 0; t < 3; ++t) {
+        intel_write_timer(t, divisors[0][t] & 0xff, divisors[0][t] >> 8);
+    }
+    const double single = hal_host_8254_counter(2)->loaded_at -
+                          hal_host_8254_counter(0)->loaded_at;
+    for (unsigned char t = 3; t < INTEL8254_COUNTERS; ++t) {
+        intel_write_timer(t, divisors[0][t] & 0xff, divisors[0][t] >> 8);
+    }
+    report("8254 update of three counters, load spread", batched, "Tcy");
+    report("  one at a time, with the divisor arithmetic (est.)",
+           single + 2 * EST_TCY_PITCH_TABLE, "Tcy");
+    for (unsigned char t = 0; t < 3; ++t) {
+        if (hal_host_8254_counter(t)->divisor != divisors[0][t]) {
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+
+// Send a message to the synth, then run the main loop for 200 ms so that
+// the oscillators have followed it, and return the divisor of an
+// oscillator.
+static unsigned int play(const unsigned char* msg, size_t len,
+                         unsigned char osc) {
+    midi_receive_span(msg, len);
+    for (int i = 0; i < 200; ++i) {
+        sched_run();
+        HAL_DELAY_MS(1);
+    }
+    return hal_host_8254_counter(osc)->divisor;
+}
+
+// The log-domain pitch path: the bend wheel covers an exact octave at any
+// note, and the detune of oscillator 1 is the same interval at any pitch.
+static int check_pitch_pipeline(void) {
+    static const unsigned char center[] = { 0xe0, 0x00, 0x40 };
+    static const unsigned char bend_up[] = { 0xe0, 0x7f, 0x7f };
+    static const unsigned char bend_down[] = { 0xe0, 0x00, 0x00 };
+    const double detune = pow(2.0, 0.4 / 12.0);
+    double worst_bend = 0;  // Cents
+    double worst_detune = 0;  // Cents
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    tuning_select(0);
+    for (unsigned char key = 36; key <= 96; key += 12) {
+        const unsigned char on[] = { 0x90, key, 100 };
+        const unsigned char off[] = { 0x80, key, 0 };
+        const double exact = INTEL8254_CLOCK_HZ /
+                             (440.0 * pow(2.0, (key - 69) / 12.0));
+
+        play(center, sizeof(center), 0);
+        const double unbent = play(on, sizeof(on), 0);
+        const double osc1 = hal_host_8254_counter(1)->divisor;
+        const double up = play(bend_up, sizeof(bend_up), 0);
+        const double down = play(bend_down, sizeof(bend_down), 0);
+        play(off, sizeof(off), 0);
+
+        // Full scale is 8191 (up) or 8192 (down) wheel units of 8192.
+        const double up_error =
+            fabs(up - exact / pow(2.0, 3071.0 / 3072)) / exact;
+        const double down_error = fabs(down - exact * 2) / (exact * 2);
+        const double detune_error = fabs(unbent / osc1 - detune);
+        worst_bend = fmax(worst_bend, 1200 * log2(1 + fmax(up_error,
+                                                           down_error)));
+        worst_detune = fmax(worst_detune,
+                            1200 * fabs(log2(unbent / osc1 / detune)));
+        if (fabs(unbent - exact) > 0.5 || up_error > 0.002 ||
+            down_error > 0.002 || detune_error > 0.002) {
+            fprintf(stderr, "key %u: divisor %.0f (exact %.1f), bent %.0f "
+                    "and %.0f, detune ratio %.4f\n", key, unbent, exact, up,
+                    down, unbent / osc1);
+            ++errors;
+        }
+    }
+    play(center, sizeof(center), 0);
+
+    report("pitch bend, worst error over C2-C7", worst_bend, "cents");
+    report("  oscillator 1 detune, worst error", worst_detune, "cents");
+    report("  exponential table size", sizeof(PITCH_EXP_TABLE) +
+           sizeof(PITCH_OCTAVE), "bytes");
+    return errors;
+}
+
+
+// A stream of MIDI timing clocks: realtime bytes, which the synth ignores,
+// that keep the receive interrupt as busy as the wire allows without
+// disturbing running status.
+#define GLIDE_LOAD_LEN 4096
+static unsigned char g_glide_load[GLIDE_LOAD_LEN];
+
+// Results of one portamento run.
+typedef struct glide_run {
+    double ms;              // Simulated time to reach the new note.
+    unsigned long ticks;    // Control ticks in that time.
+    unsigned long loads;    // Loads of all the 8254 counters in that time.
+    unsigned long writes;   // 8254 bus writes in that time.
+    unsigned long control_words;    // Control words among them (clicks.)
+} glide_run_t;
+
+// Play 'from', then 'to' legato with portamento on in the given mode, while
+// the main loop makes passes of 'pass_tcy' cycles of other work (with the
+// USART saturated if 'load' is set), and time the glide to the new note.
+static glide_run_t glide_run(unsigned char mode, unsigned int ticks,
+                             unsigned char from, unsigned char to,
+                             unsigned long pass_tcy, int load) {
+    static const unsigned char setup[] = {
+        0xe0, 0x00, 0x40,   // Bend wheel centered
+        0xb0, 65, 127       // Portamento on
+    };
+    const unsigned char first[] = { 0x90, from, 100 };
+    const unsigned char second[] = { 0x90, to, 100 };
+    const uint16_t divisor = TUNINGS[0]->divisor[to];
+    glide_run_t run = { 0, 0, 0, 0, 0 };
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    tuning_select(0);
+    set_portamento(mode, ticks);
+    play(setup, sizeof(setup), 0);
+    play(first, sizeof(first), 0);
+    if (load) {
+        memset(g_glide_load, 0xf8, sizeof(g_glide_load));
+        hal_host_usart_feed_timed(g_glide_load, sizeof(g_glide_load),
+                                  MIDI_TCY_PER_BYTE);
+    }
+
+    unsigned long loads0 = 0;
+    for (unsigned char osc = 0; osc < INTEL8254_COUNTERS; ++osc) {
+        loads0 += hal_host_8254_counter(osc)->loads;
+    }
+    const unsigned long ticks0 = hal_host_stats()->ticks;
+    const unsigned long writes0 = hal_host_stats()->bus_writes;
+    const unsigned long control_words0 = hal_host_stats()->control_words;
+    const unsigned long long cycles0 = hal_host_stats()->cycles;
+    midi_receive_span(second, sizeof(second));
+    for (;;) {
+        sched_run();
+        if (hal_host_8254_counter(0)->divisor == divisor ||
+            hal_host_stats()->cycles - cycles0 > 5000UL * HAL_HOST_TCY_PER_MS) {
+            break;
+        }
+        hal_host_delay_cycles(pass_tcy);
+    }
+    run.ms = (double) (hal_host_stats()->cycles - cycles0) /
+             HAL_HOST_TCY_PER_MS;
+    run.ticks = hal_host_stats()->ticks - ticks0;
+    run.writes = hal_host_stats()->bus_writes - writes0;
+    run.control_words = hal_host_stats()->control_words - control_words0;
+    for (unsigned char osc = 0; osc < INTEL8254_COUNTERS; ++osc) {
+        run.loads += hal_host_8254_counter(osc)->loads;
+    }
+    run.loads -= loads0;
+
+    // Leave the synth as the other benchmarks expect it.
+    static const unsigned char off[] = {
+        0x80, 0, 0, 0x80, 0, 0, 0xb0, 65, 0
+    };
+    midi_receive_span(off, sizeof(off));
+    set_portamento(GLIDE_MODE_TIME, 0);
+    hal_host_usart_feed(0, 0);
+    return run;
+}
+
+// Portamento is paced by the control tick: a glide takes its set time (or
+// the set time per octave), within one pass of the main loop, whether the
+// loop passes are quick or slow and the USART is idle or saturated. Only
+// counters whose divisor changes are written.
+static int bench_glide(void) {
+    static const struct {
+        const char* what;
+        unsigned char mode;
+        unsigned int ticks;
+        unsigned char from;
+        unsigned char to;
+        double ms;
+    } CASES[] = {
+        { "time 100 ms, octave", GLIDE_MODE_TIME, 100, 60, 72, 100 },
+        { "time 100 ms, semitone", GLIDE_MODE_TIME, 100, 60, 61, 100 },
+        { "rate 200 ms/octave, octave", GLIDE_MODE_RATE, 200, 60, 72, 200 },
+        { "rate 200 ms/octave, fifth down", GLIDE_MODE_RATE, 200, 67, 60,
+          200 * 7 / 12.0 }
+    };
+    static const unsigned long PASS_FAST = HAL_HOST_TCY_PER_MS / 10;
+    static const unsigned long PASS_SLOW = 5 * HAL_HOST_TCY_PER_MS;
+    int errors = 0;
+
+    for (size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); ++i) {
+        const glide_run_t fast = glide_run(CASES[i].mode, CASES[i].ticks,
+                                           CASES[i].from, CASES[i].to,
+                                           PASS_FAST, 0);
+        const glide_run_t slow = glide_run(CASES[i].mode, CASES[i].ticks,
+                                           CASES[i].from, CASES[i].to,
+                                           PASS_SLOW, 1);
+        char what[64];
+        snprintf(what, sizeof(what), "glide, %s", CASES[i].what);
+        report(what, fast.ms, "ms");
+        report("  with slow loop passes and the USART saturated", slow.ms,
+               "ms");
+        if (fast.control_words || slow.control_words ||
+            fabs(fast.ms - CASES[i].ms) > 2 ||
+            fabs(slow.ms - CASES[i].ms) >
+            2 + (double) PASS_SLOW / HAL_HOST_TCY_PER_MS) {
+            fprintf(stderr, "glide %s: took %.1f and %.1f ms, not %.1f\n",
+                    CASES[i].what, fast.ms, slow.ms, CASES[i].ms);
+            ++errors;
+        }
+    }
+
+    // High in the range, a pitch step is less than a count, so many ticks
+    // of a narrow glide leave some or all divisors unchanged.
+    const glide_run_t high = glide_run(GLIDE_MODE_TIME, 100, 96, 97,
+                                       PASS_FAST, 0);
+    report("glide C7 to C#7 in 100 ms, counter loads", high.loads, "");
+    report("  loads if every counter were written every tick",
+           INTEL8254_COUNTERS * high.ticks, "");
+    report("  bus writes", high.writes, "");
+    if (high.loads == 0 || high.loads >= INTEL8254_COUNTERS * high.ticks ||
+        high.control_words) {
+        ++errors;
+    }
+    return errors;
+}
+
+
+// Cost of a note on and off through the allocator with every voice
+// playing, so that each note on steals. Keys are random.
+static double voice_ns_per_note(unsigned char count, unsigned char steal) {
+    static voice_alloc_t alloc;
+    static volatile unsigned char sink;
+    voice_init(&alloc, count, steal);
+    for (unsigned char key = 0; key < count; ++key) {
+        voice_note_on(&alloc, key, key + 1);
+    }
+
+    unsigned long notes = 0;
+    double start = now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 10000; ++i) {
+            const unsigned char key = rand7();
+            sink = voice_note_on(&alloc, key, rand7());
+            sink = voice_note_off(&alloc, rand7());
+            voice_note_on(&alloc, rand7(), rand7());
+        }
+        notes += 10000;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    (void) sink;
+    return elapsed * 1e9 / notes;
+}
+
+// Voice allocation: stealing the oldest and the quietest voice, a stolen
+// key that no longer releases anything, and the cost per note with 3 and
+// 12 voices (which should be about the same.) Then the synth in poly mode:
+// a twelve-note chord plays a voice per counter at the tuning's divisors,
+// and releasing a key silences only its counter.
+static int bench_voices(void) {
+    static voice_alloc_t alloc;
+    int errors = 0;
+
+    voice_init(&alloc, VOICE_MAX, VOICE_STEAL_OLDEST);
+    for (unsigned char key = 60; key < 60 + VOICE_MAX; ++key) {
+        voice_note_on(&alloc, key, 100);
+    }
+    voice_note_on(&alloc, 60, 100);     // Played again: now the newest.
+    const unsigned char oldest = voice_of_key(&alloc, 61);
+    if (voice_note_on(&alloc, 40, 100) != oldest ||
+        voice_of_key(&alloc, 61) != VOICE_NONE ||
+        voice_note_off(&alloc, 61) != VOICE_NONE ||
+        voice_note_off(&alloc, 40) != oldest ||
+        alloc.playing != VOICE_MAX - 1) {
+        fprintf(stderr, "voices: oldest voice not stolen\n");
+        ++errors;
+    }
+
+    voice_init(&alloc, VOICE_MAX, VOICE_STEAL_QUIETEST);
+    for (unsigned char key = 60; key < 60 + VOICE_MAX; ++key) {
+        voice_note_on(&alloc, key, (key == 65 || key == 67) ? 10 : 100);
+    }
+    const unsigned char quietest = voice_of_key(&alloc, 65);
+    if (voice_note_on(&alloc, 40, 100) != quietest ||
+        voice_of_key(&alloc, 65) != VOICE_NONE ||
+        voice_of_key(&alloc, 67) == VOICE_NONE) {
+        fprintf(stderr, "voices: quietest voice not stolen\n");
+        ++errors;
+    }
+
+    g_rand_state = 1;
+    const double few = voice_ns_per_note(3, VOICE_STEAL_OLDEST);
+    const double many = voice_ns_per_note(VOICE_MAX, VOICE_STEAL_OLDEST);
+    const double quiet = voice_ns_per_note(VOICE_MAX, VOICE_STEAL_QUIETEST);
+    report("voice allocation, 3 voices, oldest, host", few, "ns/note");
+    report("  12 voices, oldest", many, "ns/note");
+    report("  12 voices, quietest", quiet, "ns/note");
+
+    // Poly mode on the synth.
+    static const unsigned char poly[] = { 0xb0, 127, 0 };
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    tuning_select(0);
+    play(poly, sizeof(poly), 0);
+    const unsigned long long cycles0 = hal_host_stats()->cycles;
+    for (unsigned char i = 0; i < INTEL8254_COUNTERS; ++i) {
+        const unsigned char on[] = { 0x90, 48 + 2 * i, 100 };
+        midi_receive_span(on, sizeof(on));
+    }
+    const double per_note = (double) (hal_host_stats()->cycles - cycles0) /
+                            INTEL8254_COUNTERS;
+    // Voices are taken from the free queue in order: key 48 + 2v gets
+    // voice (and counter) v.
+    for (unsigned char v = 0; v < INTEL8254_COUNTERS; ++v) {
+        const unsigned char key = 48 + 2 * v;
+        if (hal_host_8254_counter(v)->divisor != TUNINGS[0]->divisor[key]) {
+            fprintf(stderr, "poly: counter %u holds %u, not %u\n", v,
+                    hal_host_8254_counter(v)->divisor,
+                    TUNINGS[0]->divisor[key]);
+            ++errors;
+        }
+    }
+    static const unsigned char release[] = { 0x80, 50, 0 };
+    play(release, sizeof(release), 0);
+    for (unsigned char v = 0; v < INTEL8254_COUNTERS; ++v) {
+        const unsigned int expect =
+            (v == 1) ? 1 : TUNINGS[0]->divisor[48 + 2 * v];
+        if (hal_host_8254_counter(v)->divisor != expect) {
+            fprintf(stderr, "poly: after release, counter %u holds %u\n", v,
+                    hal_host_8254_counter(v)->divisor);
+            ++errors;
+        }
+    }
+    static const unsigned char unison[] = { 0xb0, 126, 0 };
+    play(unison, sizeof(unison), 0);
+    report("  poly note on, simulated I/O", per_note, "Tcy");
+    return errors;
+}
+
+
+// The mono note stack: last, low and high priority over the keys held,
+// removal from the middle, and the oldest key dropped when full. Then the
+// synth in unison mode: releasing the newer of two keys returns to the
+// older at once, or with portamento on, glides back to it without a
+// control word; with legato off, each change of key starts over.
+static int check_note_stack(void) {
+    static note_stack_t stack;
+    int errors = 0;
+
+    note_stack_init(&stack, NOTE_PRIORITY_LAST);
+    note_stack_push(&stack, 64);
+    note_stack_push(&stack, 60);
+    note_stack_push(&stack, 67);
+    note_stack_push(&stack, 62);
+    const unsigned char last = note_stack_current(&stack);
+    stack.priority = NOTE_PRIORITY_LOW;
+    const unsigned char low = note_stack_current(&stack);
+    stack.priority = NOTE_PRIORITY_HIGH;
+    const unsigned char high = note_stack_current(&stack);
+    note_stack_remove(&stack, 67);
+    const unsigned char high_after = note_stack_current(&stack);
+    stack.priority = NOTE_PRIORITY_LAST;
+    note_stack_remove(&stack, 62);
+    const unsigned char last_after = note_stack_current(&stack);
+    if (last != 62 || low != 60 || high != 67 || high_after != 64 ||
+        last_after != 60 || note_stack_remove(&stack, 62) ||
+        note_stack_count(&stack) != 2) {
+        fprintf(stderr, "note stack: last %u, low %u, high %u, then %u "
+                "and %u\n", last, low, high, high_after, last_after);
+        ++errors;
+    }
+    note_stack_init(&stack, NOTE_PRIORITY_LAST);
+    for (unsigned char key = 0; key < NOTE_STACK_SIZE + 2; ++key) {
+        note_stack_push(&stack, key);
+    }
+    stack.priority = NOTE_PRIORITY_LOW;
+    if (note_stack_count(&stack) != NOTE_STACK_SIZE ||
+        note_stack_current(&stack) != 2) {
+        fprintf(stderr, "note stack: oldest keys not dropped when full\n");
+        ++errors;
+    }
+
+    // On the synth.
+    static const unsigned char hold[] = { 0x90, 60, 100 };
+    static const unsigned char press[] = { 0x90, 72, 100 };
+    static const unsigned char release[] = { 0x80, 72, 0 };
+    static const unsigned char porta_on[] = { 0xb0, 65, 127, 0xb0, 5, 40 };
+    static const unsigned char legato_off[] = { 0xb0, 68, 0 };
+    static const unsigned char all_up[] = { 0x80, 60, 0, 0x80, 72, 0 };
+    const uint16_t low_divisor = TUNINGS[0]->divisor[60];
+    const uint16_t high_divisor = TUNINGS[0]->divisor[72];
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    tuning_select(0);
+    play(hold, sizeof(hold), 0);
+    play(press, sizeof(press), 0);
+    const unsigned int jumped = play(release, sizeof(release), 0);
+
+    play(porta_on, sizeof(porta_on), 0);
+    play(press, sizeof(press), 0);
+    const unsigned long words0 = hal_host_stats()->control_words;
+    midi_receive_span(release, sizeof(release));
+    sched_run();
+    const unsigned int gliding = hal_host_8254_counter(0)->divisor;
+    const unsigned int glided = play(0, 0, 0);
+    const unsigned long words = hal_host_stats()->control_words - words0;
+
+    play(legato_off, sizeof(legato_off), 0);
+    const unsigned int restarted = play(press, sizeof(press), 0);
+    const unsigned int silent = play(all_up, sizeof(all_up), 0);
+    if (jumped != low_divisor || glided != low_divisor ||
+        gliding >= low_divisor || gliding <= high_divisor || words ||
+        restarted != high_divisor || silent != 1) {
+        fprintf(stderr, "note stack: back to %u, glide at %u then %u "
+                "(%lu control words), restarted %u, then %u\n", jumped,
+                gliding, glided, words, restarted, silent);
+        ++errors;
+    }
+    report("note stack, release back to a held key, divisor", jumped, "");
+    report("  with portamento, control words while gliding back", words,
+           "");
+    return errors;
+}
+
+
+// Run the main loop for a number of milliseconds (control ticks.)
+static void run_ms(unsigned int ms) {
+    for (unsigned int i = 0; i < ms; ++i) {
+        sched_run();
+        HAL_DELAY_MS(1);
+    }
+}
+
+// Estimated PIC18 cost of rendering one modulator, which the host HAL does
+// not simulate: an envelope stage is a 32-bit compare, subtract and add
+// (about 12 Tcy each, with the moves) and the switch; an LFO is a 16-bit
+// phase add, the table read (TBLRD, about 8 Tcy) and the reflections.
+#define EST_TCY_ENVELOPE 45
+#define EST_TCY_LFO      35
+#define TCY_PER_TICK     (_XTAL_FREQ / 4 / TICK_HZ)
+
+// The modulation engine: the envelope's stages on DAC A at the set times,
+// DAC writes only while the code changes, the note playing on through the
+// release, the LFO shapes and vibrato from the mod wheel. Then the cost of
+// rendering per tick, and how many modulators would fit in half a tick.
+static int bench_modulation(void) {
+    static const unsigned char on[] = { 0x90, 69, 100 };
+    static const unsigned char off[] = { 0x80, 69, 0 };
+    static const unsigned char wheel[] = { 0xb0, 1, 127 };
+    static const unsigned char wheel_off[] = { 0xb0, 1, 0 };
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    tuning_select(0);
+    set_envelope(100, 100, ENV_LEVEL_MAX / 2, 200);
+    set_lfo(LFO_SINE, 0);
+    midi_receive_span(on, sizeof(on));
+    run_ms(50);
+    const unsigned int attack = hal_host_dac(0);
+    run_ms(200);
+    const unsigned int sustain = hal_host_dac(0);
+    const unsigned long writes0 = hal_host_stats()->dac_writes;
+    run_ms(500);
+    const unsigned long sustain_writes =
+        hal_host_stats()->dac_writes - writes0;
+    midi_receive_span(off, sizeof(off));
+    run_ms(50);
+    const unsigned int release = hal_host_dac(0);
+    const unsigned int releasing = hal_host_8254_counter(0)->divisor;
+    run_ms(100);
+    const unsigned int released = hal_host_dac(0);
+    const unsigned int silent = hal_host_8254_counter(0)->divisor;
+    if (attack < 1900 || attack > 2200 || sustain != 2047 ||
+        sustain_writes || release < 900 || release > 1100 ||
+        released || releasing != TUNINGS[0]->divisor[69] || silent != 1) {
+        fprintf(stderr, "envelope: DAC %u, %u (%lu writes), %u, %u; "
+                "divisor %u then %u\n", attack, sustain, sustain_writes,
+                release, released, releasing, silent);
+        ++errors;
+    }
+    report("envelope, DAC writes per tick while sustaining",
+           (double) sustain_writes / 500, "");
+
+    // Vibrato: the divisor swings both ways about the note.
+    set_envelope(0, 0, ENV_LEVEL_MAX, 0);
+    set_lfo(LFO_SINE, 327);
+    midi_receive_span(wheel, sizeof(wheel));
+    midi_receive_span(on, sizeof(on));
+    unsigned int lowest = 0xffff;
+    unsigned int highest = 0;
+    for (int i = 0; i < 400; ++i) {
+        run_ms(1);
+        const unsigned int d = hal_host_8254_counter(0)->divisor;
+        lowest = d < lowest ? d : lowest;
+        highest = d > highest ? d : highest;
+    }
+    midi_receive_span(off, sizeof(off));
+    midi_receive_span(wheel_off, sizeof(wheel_off));
+    run_ms(10);
+    const double cents = 1200 * log2((double) highest / lowest);
+    report("vibrato at full depth, 5 Hz, swing", cents, "cents");
+    if (cents < 150 || cents > 250) {
+        ++errors;
+    }
+
+    // LFO shapes over a cycle.
+    static lfo_t lfo;
+    int16_t low[4];
+    int16_t high[4];
+    for (unsigned char shape = 0; shape < 4; ++shape) {
+        lfo_init(&lfo);
+        lfo_set(&lfo, shape, 64);
+        low[shape] = 32767;
+        high[shape] = -32767;
+        for (int i = 0; i < 1024; ++i) {
+            const int16_t v = lfo_render(&lfo);
+            low[shape] = v < low[shape] ? v : low[shape];
+            high[shape] = v > high[shape] ? v : high[shape];
+        }
+        if (low[shape] > -32000 || high[shape] < 32000) {
+            fprintf(stderr, "LFO shape %u: %d to %d\n", shape, low[shape],
+                    high[shape]);
+            ++errors;
+        }
+    }
+
+    // Render cost.
+    static envelope_t env;
+    static volatile int sink;
+    env_init(&env);
+    env_set(&env, 1000, 1000, ENV_LEVEL_MAX / 2, 1000);
+    lfo_init(&lfo);
+    lfo_set(&lfo, LFO_SINE, 327);
+    unsigned long renders = 0;
+    double start = now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 10000; ++i) {
+            if ((i & 0x7ff) == 0) {
+                env.stage = (i & 0x800) ? ENV_RELEASE : ENV_ATTACK;
+            }
+            sink = env_render(&env) + lfo_render(&lfo);
+        }
+        renders += 10000;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    (void) sink;
+
+    const double io = synth_render_peak();
+    const double modulators = (TCY_PER_TICK / 2 - io) /
+                              ((EST_TCY_ENVELOPE + EST_TCY_LFO) / 2.0);
+    report("envelope and LFO render, host", elapsed * 1e9 / renders,
+           "ns/tick");
+    report("  tick interrupt, worst case, simulated I/O", io, "Tcy");
+    report("  envelope render, estimated PIC18", EST_TCY_ENVELOPE, "Tcy");
+    report("  LFO render, estimated PIC18", EST_TCY_LFO, "Tcy");
+    report("  modulators that fit in half a tick (est.)", modulators, "");
+    return errors;
+}
+
+
+// The SPI DAC driver, on the last DAC: a burst of writes to both its
+// channels costs the caller a few cycles each and goes out as one frame
+// in flight and one more per channel, with the latest codes; codes the
+// channels already have are not sent. Then the frames per tick that the
+// modulation engine sends with the LFO running. The previous driver sent
+// a frame by polling: two blocking WriteSPI() calls of about 20 Tcy.
+#define EST_TCY_BLOCKING_FRAME (2 * 20 + 6)
+
+static int bench_dac(void) {
+    static const unsigned int BURST = 100;
+    const unsigned char a = DAC_CHANNELS - 2;
+    const unsigned char b = DAC_CHANNELS - 1;
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    set_lfo(LFO_SINE, 0);
+    run_ms(2);
+
+    const hal_host_stats_t before = *hal_host_stats();
+    HAL_IRQ_DISABLE();
+    const unsigned long long cycles0 = hal_host_stats()->cycles;
+    for (unsigned int i = 0; i < BURST; ++i) {
+        dac_write(a, i * 40);
+        dac_write(b, 4000 - i * 40);
+    }
+    const double per_write =
+        (double) (hal_host_stats()->cycles - cycles0) / (2 * BURST);
+    HAL_IRQ_ENABLE();
+    run_ms(1);
+    const unsigned long frames = hal_host_stats()->dac_writes -
+                                 before.dac_writes;
+
+    const unsigned long frames0 = hal_host_stats()->dac_writes;
+    HAL_IRQ_DISABLE();
+    dac_write(a, (BURST - 1) * 40);
+    dac_write(b, 4000 - (BURST - 1) * 40);
+    HAL_IRQ_ENABLE();
+    run_ms(1);
+    const unsigned long redundant = hal_host_stats()->dac_writes - frames0;
+
+    if (hal_host_dac(a) != (BURST - 1) * 40 ||
+        hal_host_dac(b) != 4000 - (BURST - 1) * 40 || frames > 3 ||
+        redundant || hal_host_stats()->spi_collisions || dac_busy()) {
+        fprintf(stderr, "dac: codes %u and %u after %lu frames, %lu "
+                "redundant, %lu collisions\n", hal_host_dac(a),
+                hal_host_dac(b), frames, redundant,
+                hal_host_stats()->spi_collisions);
+        ++errors;
+    }
+    report("DAC write, I/O cost to the caller, simulated", per_write,
+           "Tcy");
+    report("  blocking frame, previous driver (est.)",
+           EST_TCY_BLOCKING_FRAME, "Tcy");
+    report("  frames sent for a burst of writes", frames, "");
+    report("  of which redundant", redundant, "");
+
+    // Two channels of modulation; the LFO changes on nearly every tick.
+    set_lfo(LFO_SINE, 327);
+    const unsigned long frames1 = hal_host_stats()->dac_writes;
+    run_ms(100);
+    report("  frames per tick, LFO at 5 Hz",
+           (double) (hal_host_stats()->dac_writes - frames1) / 100, "");
+    if (hal_host_stats()->spi_collisions) {
+        ++errors;
+    }
+    return errors;
+}
+
+
+// Run the main loop as the firmware does, continuously, for a number of
+// milliseconds: a pass every 50 us, so that passes fall at every point of
+// a tick.
+#define DISPLAY_PASS_TCY (HAL_HOST_TCY_PER_MS / 20)
+
+static void run_loop_ms(unsigned int ms) {
+    for (unsigned int i = 0; i < ms * 20; ++i) {
+        sched_run();
+        hal_host_delay_cycles(DISPLAY_PASS_TCY);
+    }
+}
+
+// Run the main loop until the LCD shows the framebuffer; return the ticks
+// that took, or 0 if it did not within a second.
+static unsigned long run_until_drawn(void) {
+    const unsigned long ticks0 = hal_host_stats()->ticks;
+    for (unsigned int i = 0; i < 20 * TICK_HZ; ++i) {
+        if (!display_dirty()) {
+            return hal_host_stats()->ticks - ticks0;
+        }
+        sched_run();
+        hal_host_delay_cycles(DISPLAY_PASS_TCY);
+    }
+    return 0;
+}
+
+// Return nonzero if the LCD shows 'row' (DISPLAY_COLS characters.)
+static int lcd_shows(unsigned char row, const char* text) {
+    for (unsigned char col = 0; col < DISPLAY_COLS; ++col) {
+        if (hal_host_lcd_ddram((row ? 0x40 : 0) + col) != text[col]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Estimated cost of the previous driver, which waited on the busy flag: a
+// character or instruction is two nibbles and then a busy wait of about
+// 40 us (160 Tcy); clear takes 1.52 ms.
+#define EST_TCY_BLOCKING_CHAR 170
+#define EST_TCY_BLOCKING_CLEAR 6100
+
+// The LCD driver: initialization and a full redraw within the instruction
+// timings, though the busy flag is never read; only the cells that change
+// are sent; the most any one service call costs; and a redraw every 50 ms
+// while MIDI streams in at the full rate, which must lose nothing.
+static int bench_display(void) {
+    static const char* const ROWS[2] = {
+        "0123456789abcdef",
+        "ghijklmnopqrstuv"
+    };
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    display_open();
+    display_move(0, 0);
+    display_write_string("    dial one");
+    const unsigned long init_ticks = run_until_drawn();
+    if (!init_ticks || !lcd_shows(0, "    dial one    ") ||
+        !lcd_shows(1, "                ") || !hal_host_lcd_on()) {
+        fprintf(stderr, "display: not initialized after %lu ticks\n",
+                init_ticks);
+        ++errors;
+    }
+
+    display_move(0, 0);
+    display_write_string(ROWS[0]);
+    display_move(1, 0);
+    display_write_string(ROWS[1]);
+    const unsigned long redraw_ticks = run_until_drawn();
+    if (!lcd_shows(0, ROWS[0]) || !lcd_shows(1, ROWS[1])) {
+        fprintf(stderr, "display: full redraw does not match\n");
+        ++errors;
+    }
+
+    // One cell, then the same string again (nothing to send.)
+    unsigned long bytes0 = hal_host_stats()->lcd_bytes;
+    display_move(1, 5);
+    display_write_string("L");
+    run_until_drawn();
+    const unsigned long one_cell = hal_host_stats()->lcd_bytes - bytes0;
+    bytes0 = hal_host_stats()->lcd_bytes;
+    display_move(0, 0);
+    display_write_string(ROWS[0]);
+    run_loop_ms(5);
+    const unsigned long unchanged = hal_host_stats()->lcd_bytes - bytes0;
+    if (hal_host_lcd_ddram(0x45) != 'L' || one_cell != 2 || unchanged) {
+        fprintf(stderr, "display: %lu bytes for one cell, %lu for none\n",
+                one_cell, unchanged);
+        ++errors;
+    }
+
+    // The most I/O one service call costs, called once a tick at a point
+    // that drifts through the tick.
+    display_clear();
+    HAL_IRQ_DISABLE();
+    unsigned long peak = 0;
+    while (display_dirty()) {
+        const unsigned long long cycles0 = hal_host_stats()->cycles;
+        display_service();
+        const unsigned long spent =
+            (unsigned long) (hal_host_stats()->cycles - cycles0);
+        if (spent > peak) {
+            peak = spent;
+        }
+        hal_host_delay_cycles(HAL_HOST_TCY_PER_MS * 1000 / TICK_HZ + 37);
+    }
+    HAL_IRQ_ENABLE();
+
+    // Redraw the whole screen every 50 ms while the stream plays.
+    const unsigned long len = make_stream(g_stream, RX_REPLAY_LEN / 4);
+    const unsigned long lost0 = hal_host_stats()->rx_lost;
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    unsigned int frames = 0;
+    while (!hal_host_usart_done()) {
+        char line[DISPLAY_COLS + 1];
+        snprintf(line, sizeof(line), "frame %10u", frames);
+        display_move(frames & 1, 0);
+        display_write_string(line);
+        display_move(!(frames & 1), 0);
+        display_write_string(ROWS[frames & 1]);
+        ++frames;
+        run_loop_ms(50);
+    }
+    run_until_drawn();
+    const unsigned long lost = hal_host_stats()->rx_lost - lost0;
+    if (lost || hal_host_stats()->lcd_violations) {
+        fprintf(stderr, "display: %lu bytes lost while redrawing, %lu busy "
+                "violations\n", lost, hal_host_stats()->lcd_violations);
+        ++errors;
+    }
+
+    report("LCD initialization", init_ticks, "ticks");
+    report("  full redraw (32 cells)", redraw_ticks, "ticks");
+    report("  bytes sent to change one cell", one_cell, "");
+    report("  most I/O per service call, simulated", peak, "Tcy");
+    report("  blocking full redraw, previous driver (est.)",
+           EST_TCY_BLOCKING_CLEAR + 34 * EST_TCY_BLOCKING_CHAR, "Tcy");
+    report("  frames redrawn while MIDI streamed", frames, "");
+    report("  busy violations", hal_host_stats()->lcd_violations, "");
+    return errors;
+}
+
+
+// The scheduler, with every task busy: a note gliding with vibrato, the
+// LCD redrawn every 20 ms and MIDI streaming in at the full rate. No tick
+// task may miss its deadline or the stream lose a byte, and MIDI must
+// wait, at worst, for one run of another task (under a tick; the longest
+// is a pitch update that waits on 8254 edges to change counter formats),
+// where the loop it replaced ran all of them in turn.
+static int bench_scheduler(void) {
+    static const unsigned char setup[] = {
+        0xb0, 65, 127,      // Portamento on
+        0xb0, 5, 40,        // Portamento time
+        0xb0, 1, 127,       // Mod wheel (vibrato) at full depth
+        0x90, 48, 100,      // Note on
+        0x90, 72, 100       // Note on (legato, gliding)
+    };
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    display_open();
+    midi_receive_span(setup, sizeof(setup));
+    run_loop_ms(100);
+    sched_reset_stats();
+
+    const unsigned long len = make_stream(g_stream, RX_REPLAY_LEN / 4);
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    unsigned int frames = 0;
+    while (!hal_host_usart_done()) {
+        char line[DISPLAY_COLS + 1];
+        snprintf(line, sizeof(line), "%16u", frames++);
+        display_move(frames & 1, 0);
+        display_write_string(line);
+        run_loop_ms(20);
+    }
+
+    uint16_t worst_others = 0;
+    uint16_t pass = 0;
+    for (unsigned char i = 0; i < sched_task_count(); ++i) {
+        const sched_task_t* task = sched_task(i);
+        char what[64];
+        snprintf(what, sizeof(what), "  %s: runs, worst, over budget, missed",
+                 task->name);
+        printf("%-48s %8lu %5u Tcy %3lu %3lu\n", what, task->runs,
+               task->worst * 16, task->overruns, task->misses);
+        if (task->ready == 0 && task->misses) {
+            ++errors;
+        }
+        if (i) {
+            pass += task->worst;
+            if (task->worst > worst_others) {
+                worst_others = task->worst;
+            }
+        }
+    }
+    const uint16_t blocking = sched_blocking(0);
+    if (hal_host_stats()->rx_lost || blocking != worst_others ||
+        blocking * 16 >= TCY_PER_TICK) {
+        fprintf(stderr, "scheduler: MIDI blocked for %u Tcy, %lu bytes "
+                "lost\n", blocking * 16, hal_host_stats()->rx_lost);
+        ++errors;
+    }
+    report("scheduler, MIDI wait behind other tasks, worst", blocking * 16,
+           "Tcy");
+    report("  one pass of every task, as loop() ran them", pass * 16, "Tcy");
+    return errors;
+}
+
+
+// A backlog of notes, queued while the main loop was held up, and then
+// dispatched: the MIDI task must yield once it has used its budget, rather
+// than dispatch the whole run eventq_peek() hands it, and the queue must
+// still drain. The budget is checked before each event, so a run may go
+// over it by one event, and a tick interrupt that came in meanwhile.
+#define MIDI_BUDGET_SLACK_TCY 500
+
+static int bench_midi_budget(void) {
+    static unsigned char backlog[64];
+    unsigned long len = 0;
+    int errors = 0;
+
+    backlog[len++] = 0x90;
+    for (unsigned char i = 0; i < 15; ++i) {
+        backlog[len++] = 60 + i % 12;
+        backlog[len++] = 100;
+        backlog[len++] = 60 + i % 12;
+        backlog[len++] = 0;
+    }
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    run_loop_ms(10);
+    hal_host_usart_feed_timed(backlog, len, MIDI_TCY_PER_BYTE);
+    while (!hal_host_usart_done()) {
+        HAL_DELAY_MS(1);
+    }
+    const unsigned char queued = eventq_available();
+    sched_reset_stats();
+    run_loop_ms(10);
+
+    const sched_task_t* midi = sched_task(0);
+    report("MIDI backlog dispatched, events", queued, "");
+    report("  longest MIDI task run", midi->worst * 16, "Tcy");
+    report("  of a budget of", midi->budget * 16, "Tcy");
+    if (eventq_available() || midi->runs < 2 ||
+        midi->worst > midi->budget + SCHED_TCY(MIDI_BUDGET_SLACK_TCY)) {
+        fprintf(stderr, "MIDI backlog: longest run %u Tcy, %u events left\n",
+                midi->worst * 16, eventq_available());
+        ++errors;
+    }
+    return errors;
+}
+
+
+// The clock: it must keep time with the simulation across overflows of
+// its timer. Then the latency of a note on, from the receive interrupt's
+// stamp to the 8254 write, alone and while the other tasks are busy.
+static int bench_clock(void) {
+    static const unsigned char note[] = { 0x90, 60, 100 };
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    display_open();
+    const uint32_t start = clock_now();
+    const unsigned long long cycles0 = hal_host_stats()->cycles;
+    run_loop_ms(500);
+    const uint32_t elapsed = clock_now() - start;
+    const unsigned long expected =
+        (unsigned long) ((hal_host_stats()->cycles - cycles0) / 4);
+    if (elapsed + 1 < expected || elapsed > expected + 1 ||
+        hal_host_stats()->clock_overflows < 7) {
+        fprintf(stderr, "clock: %lu us elapsed, expected %lu\n",
+                (unsigned long) elapsed, expected);
+        ++errors;
+    }
+
+    hal_host_usart_feed_timed(note, sizeof(note), MIDI_TCY_PER_BYTE);
+    run_loop_ms(5);
+    const uint16_t alone = synth_note_latency(0);
+    if (alone == 0 || alone > 1000000 / TICK_HZ / 4) {
+        fprintf(stderr, "clock: note on latency %u us\n", alone);
+        ++errors;
+    }
+
+    // Notes in a stream at the full rate, the LCD redrawn every 20 ms.
+    const unsigned long len = make_stream(g_stream, RX_REPLAY_LEN / 4);
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    unsigned int frames = 0;
+    while (!hal_host_usart_done()) {
+        char line[DISPLAY_COLS + 1];
+        snprintf(line, sizeof(line), "%16u", frames++);
+        display_move(frames & 1, 0);
+        display_write_string(line);
+        run_loop_ms(20);
+    }
+    const uint16_t peak = synth_note_latency(1);
+    if (peak >= 2 * 1000000 / TICK_HZ) {
+        fprintf(stderr, "clock: note on latency up to %u us\n", peak);
+        ++errors;
+    }
+
+    report("clock, error after 500 ms", (double) elapsed - expected, "us");
+    report("  note on, arrival to 8254 write, alone", alone, "us");
+    report("  worst, with MIDI streaming and the LCD busy", peak, "us");
+    return errors;
+}
+
+
+// Return nonzero if the first oscillator is sounding (not silenced.)
+static int sounding(void) {
+    return hal_host_8254_counter(0)->divisor > 1;
+}
+
+// Feed bytes at the MIDI rate and run the main loop until they are in and
+// handled.
+static void send(const unsigned char* bytes, size_t len) {
+    hal_host_usart_feed_timed(bytes, len, MIDI_TCY_PER_BYTE);
+    while (!hal_host_usart_done()) {
+        run_ms(1);
+    }
+    sched_run();
+}
+
+// The watchdog: with active sensing, a note held through a silent input
+// is silenced just after 300 ms, and not while FE keeps coming; without
+// it, a note is held however long the input is quiet. Then all notes off
+// (a release), all sound off and reset, which also restores the settings.
+static int check_watchdog(void) {
+    static const unsigned char sense_note[] = { 0xfe, 0x90, 60, 100 };
+    static const unsigned char sense[] = { 0xfe };
+    static const unsigned char note[] = { 0x90, 60, 100 };
+    static const unsigned char notes_off[] = { 0xb0, 123, 0 };
+    static const unsigned char sound_off[] = { 0xb0, 120, 0 };
+    static const unsigned char reset[] = { 0xe0, 0, 0x70, 0xff };
+    static const unsigned char release[] = { 0xb0, 72, 64 };
+    static const unsigned char settings[] = { 0xc0, 1, 0xb0, 65, 127, 5, 127 };
+    static const unsigned char note_off[] = { 0x80, 60, 0 };
+    static const unsigned char note_e[] = { 0x90, 64, 100 };
+    static const unsigned char note_e_off[] = { 0x80, 64, 0 };
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    send(sense_note, sizeof(sense_note));
+    for (int i = 0; i < 10; ++i) {
+        run_ms(200);
+        send(sense, sizeof(sense));
+    }
+    const int kept = sounding();
+    const unsigned long long quiet0 = hal_host_stats()->cycles;
+    for (int i = 0; sounding() && i < 1000; ++i) {
+        run_ms(1);
+    }
+    const unsigned int quiet = (unsigned int)
+        ((hal_host_stats()->cycles - quiet0) / HAL_HOST_TCY_PER_MS);
+    if (!kept || quiet < 300 || quiet > 302) {
+        fprintf(stderr, "watchdog: note %s while sensing, silenced after "
+                "%u ms\n", kept ? "kept" : "lost", quiet);
+        ++errors;
+    }
+
+    // The timeout disarmed sensing; a note now plays on.
+    send(note, sizeof(note));
+    run_ms(1000);
+    if (!sounding()) {
+        fprintf(stderr, "watchdog: note silenced without active sensing\n");
+        ++errors;
+    }
+
+    // All notes off releases (the envelope runs on); all sound off doesn't.
+    send(release, sizeof(release));
+    send(notes_off, sizeof(notes_off));
+    const int releasing = sounding() && hal_host_dac(0) > 0;
+    run_ms(2000);
+    if (!releasing || sounding()) {
+        fprintf(stderr, "watchdog: all notes off did not release\n");
+        ++errors;
+    }
+    send(note, sizeof(note));
+    run_ms(10);
+    send(sound_off, sizeof(sound_off));
+    run_ms(2);
+    if (sounding() || hal_host_dac(0) != 0) {
+        fprintf(stderr, "watchdog: all sound off did not silence\n");
+        ++errors;
+    }
+
+    // Reset silences, centers the bend wheel and disarms sensing.
+    send(sense_note, sizeof(sense_note));
+    send(reset, sizeof(reset));
+    run_ms(2);
+    const int reset_silent = !sounding();
+    send(note, sizeof(note));
+    const unsigned int centered = hal_host_8254_counter(0)->divisor;
+    run_ms(1000);
+    send(sound_off, sizeof(sound_off));
+    send(note, sizeof(note));
+    if (!reset_silent || !sounding() ||
+        hal_host_8254_counter(0)->divisor != centered) {
+        fprintf(stderr, "watchdog: reset did not return to power-up\n");
+        ++errors;
+    }
+
+    // Reset also restores the settings: with the just tuning, a slow glide
+    // and the slow release in place beforehand, E lands on its power-up
+    // divisor at once and stops at note off.
+    send(sound_off, sizeof(sound_off));
+    send(settings, sizeof(settings));
+    send(reset, sizeof(reset));
+    send(note, sizeof(note));
+    send(note_e, sizeof(note_e));
+    run_ms(2);
+    const unsigned int gliding = hal_host_8254_counter(0)->divisor;
+    send(note_off, sizeof(note_off));
+    send(note_e_off, sizeof(note_e_off));
+    run_ms(2);
+    const int stopped = !sounding();
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    send(note_e, sizeof(note_e));
+    run_ms(2);
+    if (!stopped || gliding != hal_host_8254_counter(0)->divisor) {
+        fprintf(stderr, "watchdog: reset kept the tuning, glide or "
+                "envelope settings\n");
+        ++errors;
+    }
+
+    report("active sensing, note silenced after", quiet, "ms");
+    return errors;
+}
+
+
+// The resident tuning tables generated from tunings/: equal temperament
+// must agree with the pitch tables, the just scale must have pure fifths,
+// and selecting a tuning must change the divisor that a note-on loads.
+static int check_tunings(void) {
+    const tuning_t* tet = TUNINGS[0];
+    const tuning_t* just = TUNINGS[1];
+    int errors = 0;
+
+    for (unsigned char key = 0; key < 128; ++key) {
+        const pitch_t pitch = PITCH_FROM_NOTE(key);
+        const int diff = tet->divisor[key] - pitch_to_divisor(pitch);
+        if (tet->pitch[key] != pitch ||
+            (pitch >= PITCH_MIN && (diff < -1 || diff > 1))) {
+            fprintf(stderr, "12TET tuning differs from pitch tables at "
+                    "key %u\n", key);
+            ++errors;
+            break;
+        }
+    }
+
+    // G4 over C4 is 3/2 (701.955 cents); C4 is the equal-tempered C4.
+    const double fifth = 701.955 * PITCH_STEPS_PER_SEMITONE / 100;
+    if (just->pitch[60] != tet->pitch[60] ||
+        fabs(just->pitch[67] - just->pitch[60] - fifth) > 0.5) {
+        fprintf(stderr, "just tuning: fifth is %d steps, not %.1f\n",
+                just->pitch[67] - just->pitch[60], fifth);
+        ++errors;
+    }
+
+    hal_host_reset();
+    system_init();
+    for (unsigned char t = 0; t < TUNING_COUNT; ++t) {
+        static const unsigned char change[] = {
+            0xe0, 0x00, 0x40,   // Bend wheel centered
+            0xc0, 0,            // Program change; patched below
+            0x90, 64, 100       // Note on
+        };
+        unsigned char bytes[sizeof(change)];
+        memcpy(bytes, change, sizeof(change));
+        bytes[4] = t;
+        midi_receive_span(bytes, sizeof(bytes));
+        if (hal_host_8254_counter(0)->divisor != TUNINGS[t]->divisor[64]) {
+            fprintf(stderr, "program change did not select tuning %s\n",
+                    TUNINGS[t]->name);
+            ++errors;
+        }
+        midi_receive_span((const uint8_t*) "\x80\x40\x00", 3);
+    }
+    tuning_select(0);
+    if (tuning_select(TUNING_COUNT) != E_TUNING_BAD_INDEX ||
+        tuning_current() != TUNINGS[0]) {
+        fprintf(stderr, "tuning_select() accepted a bad index\n");
+        ++errors;
+    }
+
+    report("resident tunings", TUNING_COUNT, "");
+    report("  program memory per tuning", sizeof(tuning_t), "bytes");
+    return errors;
+}
+
+
+// Replay a saturated stream at 31250 baud through the USART while the main
+// loop makes slow passes, and check that every byte comes out of the ring
+// buffer intact. For comparison, also run the old one-byte-per-pass polling.
+static int bench_rx_ring(void) {
+    const unsigned long len = make_stream(g_stream, RX_REPLAY_LEN);
+    unsigned long received = 0;
+    ioport_stats_t stats;
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_ring);
+    ioport_init(MIDI_BAUD_RATE);
+    HAL_IRQ_ENABLE();
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+
+    while (!hal_host_usart_done() || ioport_available()) {
+        char byte = 0;
+        while (ioport_read_nonblocking(&byte)) {
+            if (received >= len || (unsigned char) byte != g_stream[received]) {
+                ++errors;
+            }
+            ++received;
+        }
+        HAL_DELAY_MS(RX_SLOW_PASS_MS);
+    }
+    ioport_get_stats(&stats);
+
+    report("rx ring replay at 31250 baud, bytes sent", len, "bytes");
+    report("  bytes received intact", received - errors, "bytes");
+    report("  dropped (ring full)", stats.rx_dropped, "bytes");
+    report("  lost (hardware FIFO overrun)", hal_host_stats()->rx_lost,
+           "bytes");
+    report("  ring high-water mark", stats.rx_high_water, "bytes");
+
+    if (received != len || stats.rx_dropped || hal_host_stats()->rx_lost) {
+        fprintf(stderr, "rx ring: %lu of %lu bytes received, %lu dropped, "
+                "%lu lost\n", received, len, stats.rx_dropped,
+                hal_host_stats()->rx_lost);
+        ++errors;
+    }
+
+    // The same stream, polled once per pass as loop() used to do.
+    hal_host_reset();
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    received = 0;
+    while (!hal_host_usart_done()) {
+        if (HAL_USART_RX_READY()) {
+            HAL_USART_RX_READ();
+            ++received;
+        }
+        HAL_DELAY_MS(RX_SLOW_PASS_MS);
+    }
+    report("  polled once per pass, for comparison: lost",
+           hal_host_stats()->rx_lost, "bytes");
+
+    return errors;
+}
+
+
+// Replay the stream with occasional framing errors while the main loop
+// periodically masks interrupts for long enough to overrun the USART, and
+// check that reception recovers each time and every byte is accounted for.
+static int bench_rx_errors(void) {
+    const unsigned long len = make_stream(g_stream, RX_REPLAY_LEN);
+    unsigned long received = 0;
+    unsigned long passes = 0;
+    ioport_stats_t stats;
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_ring);
+    ioport_init(MIDI_BAUD_RATE);
+    HAL_IRQ_ENABLE();
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    hal_host_usart_set_framing_errors(997);
+
+    while (!hal_host_usart_done() || ioport_available()) {
+        char byte = 0;
+        while (ioport_read_nonblocking(&byte)) {
+            ++received;
+        }
+        if (++passes % 100 == 0) {
+            HAL_IRQ_DISABLE();
+            HAL_DELAY_MS(3);
+            HAL_IRQ_ENABLE();
+        } else {
+            HAL_DELAY_MS(1);
+        }
+    }
+    ioport_get_stats(&stats);
+
+    const unsigned long lost = hal_host_stats()->rx_lost;
+    report("rx errors replay, bytes sent", len, "bytes");
+    report("  bytes read from the USART", stats.rx_bytes, "bytes");
+    report("  overruns recovered", stats.rx_overruns, "");
+    report("  lost to overruns", lost, "bytes");
+    report("  framing errors discarded", stats.rx_framing, "bytes");
+    report("  bytes delivered", received, "bytes");
+
+    // Every byte must be delivered, discarded or lost, and reception must
+    // carry on after each overrun rather than stall.
+    if (stats.rx_bytes + lost != len ||
+        received != stats.rx_bytes - stats.rx_framing - stats.rx_dropped ||
+        stats.rx_overruns == 0 ||
+        received < len - len / 10) {
+        fprintf(stderr, "rx errors: %lu of %lu bytes delivered\n",
+                received, len);
+        ++errors;
+    }
+    return errors;
+}
+
+
+// Nonzero for continuous data, which the event queue hands out behind the
+// notes: the rule in eventq.h.
+static int control_class(const midi_event_t* e) {
+    switch (e->type) {
+        case EVT_CHAN_PITCH_BEND:
+        case EVT_CHAN_AFTERTOUCH:
+            return 1;
+        case EVT_CHAN_CONTROL_CHANGE:
+            return e->data1 < 64 || (e->data1 > 69 && e->data1 < 96);
+    }
+    return 0;
+}
+
+// Nonzero if event b replaces event a, queued just before it in its class
+// and not yet taken, in the event queue: the rule in eventq.h.
+static int replaces(const midi_event_t* a, const midi_event_t* b) {
+    if (a->type != b->type || a->channel != b->channel) {
+        return 0;
+    }
+    switch (b->type) {
+        case EVT_CHAN_PITCH_BEND:
+        case EVT_CHAN_AFTERTOUCH:
+            return 1;
+        case EVT_CHAN_POLY_AFTERTOUCH:
+            return a->data1 == b->data1;
+        case EVT_CHAN_CONTROL_CHANGE:
+            return a->data1 == b->data1 && b->data1 < 96 &&
+                   (b->data1 < 64 || b->data1 > 69);
+    }
+    return 0;
+}
+
+// A sustain tap and a portamento tap, queued while the main loop is held
+// up: switches change state, so both the press and the release must be
+// dispatched, where two mod wheel values are coalesced into the latest.
+static int check_event_queue_switches(void) {
+    static const unsigned char taps[] = {
+        0xb0, 64, 127, 64, 0,   // Sustain pressed and released
+        0xb1, 65, 127, 65, 0,   // Portamento on and off
+        0xb0, 1, 20, 1, 90      // Mod wheel, twice
+    };
+    static const midi_event_t expected[] = {
+        { EVT_CHAN_CONTROL_CHANGE, 0, 64, 127 },
+        { EVT_CHAN_CONTROL_CHANGE, 0, 64, 0 },
+        { EVT_CHAN_CONTROL_CHANGE, 1, 65, 127 },
+        { EVT_CHAN_CONTROL_CHANGE, 1, 65, 0 },
+        { EVT_CHAN_CONTROL_CHANGE, 0, 1, 90 }
+    };
+    const unsigned int count = sizeof(expected) / sizeof(expected[0]);
+    midi_event_t taken[8];
+    unsigned int n = 0;
+    int errors = 0;
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    ioport_init(MIDI_BAUD_RATE);
+    eventq_init();
+    HAL_IRQ_ENABLE();
+    hal_host_usart_feed_timed(taps, sizeof(taps), MIDI_TCY_PER_BYTE);
+    while (!hal_host_usart_done()) {
+        HAL_DELAY_MS(1);
+    }
+    const midi_event_t* events = 0;
+    const uint16_t* times = 0;
+    unsigned char run = 0;
+    while ((run = eventq_peek(&events, &times)) != 0) {
+        for (unsigned char i = 0; i < run && n < 8; ++i) {
+            taken[n++] = events[i];
+        }
+        eventq_consume(run);
+    }
+    if (n != count || memcmp(taken, expected, sizeof(expected)) != 0) {
+        fprintf(stderr, "event queue: switch taps coalesced, %u of %u "
+                "events dispatched\n", n, count);
+        ++errors;
+    }
+    return errors;
+}
+
+// Replay a stream at 31250 baud through the event queue while the main
+// loop makes slow passes, taking what has queued up at each, and check the
+// events taken against those a parser decodes from the whole stream, class
+// by class: each must be the next expected of its class, or the last of a
+// run of them that replace one another. Return the events taken; count
+// those that don't match, and the most continuous data taken in a pass
+// ahead of a note on.
+static unsigned long replay_queue(const unsigned char* stream,
+                                  unsigned long len,
+                                  const midi_event_t* expected,
+                                  unsigned long count,
+                                  unsigned char priority,
+                                  unsigned long* mismatched,
+                                  unsigned int* ahead) {
+    static midi_event_t classes[2][RX_REPLAY_LEN];
+    unsigned long class_count[2] = { 0, 0 };
+    unsigned long class_next[2] = { 0, 0 };
+    unsigned long taken = 0;
+
+    for (unsigned long i = 0; i < count; ++i) {
+        const int c = control_class(&expected[i]);
+        classes[c][class_count[c]++] = expected[i];
+    }
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    ioport_init(MIDI_BAUD_RATE);
+    eventq_init();
+    eventq_set_priority(priority);
+    HAL_IRQ_ENABLE();
+    hal_host_usart_feed_timed(stream, len, MIDI_TCY_PER_BYTE);
+
+    *mismatched = 0;
+    *ahead = 0;
+    while (!hal_host_usart_done() || eventq_available()) {
+        const midi_event_t* events = 0;
+        const uint16_t* times = 0;
+        unsigned char n = 0;
+        unsigned int controls = 0;
+        while ((n = eventq_peek(&events, &times)) != 0) {
+            for (unsigned char i = 0; i < n; ++i, ++taken) {
+                const int c = control_class(&events[i]);
+                controls += c;
+                if (events[i].type == EVT_CHAN_NOTE_ON && controls > *ahead) {
+                    *ahead = controls;
+                }
+                const midi_event_t* const want = classes[c];
+                unsigned long next = class_next[c];
+                while (next + 1 < class_count[c] &&
+                       memcmp(&events[i], &want[next],
+                              sizeof(midi_event_t)) != 0 &&
+                       replaces(&want[next], &want[next + 1])) {
+                    ++next;
+                }
+                if (next >= class_count[c] ||
+                    memcmp(&events[i], &want[next],
+                           sizeof(midi_event_t)) != 0) {
+                    ++*mismatched;
+                }
+                class_next[c] = next + 1;
+            }
+            eventq_consume(n);
+        }
+        HAL_DELAY_MS(RX_SLOW_PASS_MS);
+    }
+    if (class_next[0] != class_count[0] || class_next[1] != class_count[1]) {
+        ++*mismatched;
+    }
+    return taken;
+}
+
+// A controller flood: the bend wheel swept and the mod wheel moved as
+// fast as the wire allows, and a short note on channel 1, with a change of
+// pressure while it sounds, every 32 messages. The bends go round a number
+// of channels (as from an MPE controller, each of whose notes has its
+// own), or stay on channel 1, with running status.
+static unsigned long make_flood(unsigned char* buf, unsigned long len,
+                                unsigned char channels) {
+    unsigned long n = 0;
+    unsigned int step = 0;
+    while (n + 16 <= len) {
+        if (step % 32 == 31) {
+            const unsigned char key = 48 + step / 32 % 24;
+            buf[n++] = 0x90;
+            buf[n++] = key;
+            buf[n++] = 100;
+            buf[n++] = 0xa0;
+            buf[n++] = key;
+            buf[n++] = step & 0x7f;
+            buf[n++] = 0x90;
+            buf[n++] = key;
+            buf[n++] = 0;
+        }
+        const unsigned int bend = (step * 97) & 0x3fff;
+        if (channels > 1 || step % 32 == 0 || step % 32 == 31) {
+            buf[n++] = 0xe0 | (step % channels);
+        }
+        buf[n++] = bend & 0x7f;
+        buf[n++] = bend >> 7;
+        if (step % 8 == 7) {
+            buf[n++] = 0xb0;
+            buf[n++] = 1;
+            buf[n++] = step & 0x7f;
+            buf[n++] = 0xe0;
+        }
+        ++step;
+    }
+    return n;
+}
+
+// The event queue: the random stream, then a controller flood, replayed
+// while the main loop makes slow passes. Every message must be dispatched
+// as decoded from the whole stream, save for bend and controller values
+// replaced before the main loop took them, with the notes and their poly
+// aftertouch in order; and decoded in the receive interrupt, so that no
+// byte is left waiting in the ring for the main loop (no more than the
+// USART's FIFO holds at a time.)
+static int bench_event_queue(void) {
+    static midi_event_t expected[RX_REPLAY_LEN];
+    static midi_parser_t reference;
+    unsigned long mismatched = 0;
+    unsigned int ahead = 0;
+    ioport_stats_t rx;
+    eventq_stats_t stats;
+    int errors = check_event_queue_switches();
+
+    unsigned long len = make_stream(g_stream, RX_REPLAY_LEN);
+    midi_parser_init(&reference);
+    unsigned long count = midi_parser_receive_buffer(&reference, g_stream,
+                                                     len, expected, len);
+    const unsigned long taken = replay_queue(g_stream, len, expected, count,
+                                             1, &mismatched, &ahead);
+    ioport_get_stats(&rx);
+    eventq_get_stats(&stats);
+
+    report("event queue replay, messages received", stats.events, "");
+    report("  dispatched", taken, "");
+    report("  coalesced", stats.coalesced, "");
+    report("  dropped (queue full)", stats.dropped, "");
+    report("  queue high-water mark", stats.high_water, "events");
+    report("  most bytes waiting undecoded", rx.rx_high_water, "bytes");
+    if (mismatched || stats.dropped || stats.events != count ||
+        taken + stats.coalesced != count || rx.rx_high_water > 2) {
+        fprintf(stderr, "event queue: %lu of %lu messages dispatched, "
+                "%lu wrong, %lu dropped, %u bytes waiting\n", taken, count,
+                mismatched, stats.dropped, rx.rx_high_water);
+        ++errors;
+    }
+
+    len = make_flood(g_stream, RX_REPLAY_LEN, 1);
+    midi_parser_init(&reference);
+    count = midi_parser_receive_buffer(&reference, g_stream, len, expected,
+                                       len);
+    unsigned long notes = 0;
+    unsigned long pressures = 0;
+    for (unsigned long i = 0; i < count; ++i) {
+        notes += expected[i].type == EVT_CHAN_NOTE_ON;
+        pressures += expected[i].type == EVT_CHAN_POLY_AFTERTOUCH;
+    }
+    unsigned int in_order = 0;
+    replay_queue(g_stream, len, expected, count, 0, &mismatched, &in_order);
+    eventq_get_stats(&stats);
+    const unsigned long ordered_dispatched = stats.events - stats.coalesced;
+    if (mismatched || stats.dropped) {
+        fprintf(stderr, "controller flood in arrival order: %lu wrong, %lu "
+                "dropped\n", mismatched, stats.dropped);
+        ++errors;
+    }
+
+    const unsigned long flood_taken = replay_queue(g_stream, len, expected,
+                                                   count, 1, &mismatched,
+                                                   &ahead);
+    eventq_get_stats(&stats);
+
+    report("controller flood, messages received", stats.events, "");
+    report("  dispatched", flood_taken, "");
+    report("  dispatched in arrival order (no priority)", ordered_dispatched,
+           "");
+    report("  of which notes (all kept, in order)", notes, "");
+    report("  of which poly aftertouch (with its note)", pressures, "");
+    report("  notes queued ahead of continuous data", stats.ahead, "");
+    report("  continuous data taken before a note, most", ahead, "");
+    report("  in arrival order", in_order, "");
+    if (mismatched || stats.dropped ||
+        flood_taken + stats.coalesced != count ||
+        flood_taken > count / 2 || ahead != 0 || stats.ahead == 0) {
+        fprintf(stderr, "controller flood: %lu of %lu messages dispatched, "
+                "%lu wrong, %lu dropped, %u ahead of a note\n", flood_taken,
+                count, mismatched, stats.dropped, ahead);
+        ++errors;
+    }
+    return errors;
+}
+
+// System exclusive on the queued input: dumps between notes, received
+// while the main loop makes slow passes. The payload must reach the sysex
+// handler whole, from the receive interrupt, and the notes the queue.
+static int bench_event_queue_sysex(void) {
+    const unsigned long dump = 200;
+    unsigned long len = 0;
+    unsigned long messages = 0;
+    unsigned long sum = 0;
+    unsigned long notes = 0;
+    unsigned long taken = 0;
+    eventq_stats_t stats;
+    int errors = 0;
+
+    g_rand_state = 5;
+    while (len + dump + 8 <= RX_REPLAY_LEN) {
+        const unsigned char key = 36 + rand7() % 48;
+        g_stream[len++] = 0x90;
+        g_stream[len++] = key;
+        g_stream[len++] = 100;
+        g_stream[len++] = 0xf0;
+        for (unsigned long i = 0; i < dump; ++i) {
+            g_stream[len] = rand7();
+            sum += g_stream[len++];
+        }
+        g_stream[len++] = 0xf7;
+        g_stream[len++] = 0x80;
+        g_stream[len++] = key;
+        g_stream[len++] = 0;
+        notes += 2;
+        ++messages;
+    }
+
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    ioport_init(MIDI_BAUD_RATE);
+    eventq_init();
+    eventq_register_sysex_handler(sum_sysex);
+    g_sysex_bytes = 0;
+    g_sysex_sum = 0;
+    g_sysex_messages = 0;
+    HAL_IRQ_ENABLE();
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    while (!hal_host_usart_done() || eventq_available()) {
+        const midi_event_t* events = 0;
+        const uint16_t* times = 0;
+        unsigned char n = 0;
+        while ((n = eventq_peek(&events, &times)) != 0) {
+            taken += n;
+            eventq_consume(n);
+        }
+        HAL_DELAY_MS(RX_SLOW_PASS_MS);
+    }
+    eventq_register_sysex_handler(0);
+    eventq_get_stats(&stats);
+
+    report("event queue, SysEx payload received", g_sysex_bytes, "bytes");
+    if (g_sysex_messages != messages || g_sysex_bytes != messages * dump ||
+        g_sysex_sum != sum || taken != notes || stats.dropped) {
+        fprintf(stderr, "event queue: SysEx payload %lu of %lu bytes, %lu "
+                "of %lu notes\n", g_sysex_bytes, messages * dump, taken,
+                notes);
+        ++errors;
+    }
+    return errors;
+}
+
+// Estimated PIC18 cost of dispatching a bend or controller, which the host
+// HAL does not simulate: the dispatch and handler call (about 40 Tcy), the
+// 14-bit bend assembled and scaled in 32 bits (about 120 Tcy), or a
+// controller's switch and scaling.
+#define EST_TCY_CONTROL_EVENT 160
+
+static void costly_bend(char chan, char lsb, char msb) {
+    on_pitch_bend(chan, lsb, msb);
+    hal_host_delay_cycles(EST_TCY_CONTROL_EVENT);
+}
+
+static void costly_control_change(char chan, char controller, char value) {
+    on_control_change(chan, controller, value);
+    hal_host_delay_cycles(EST_TCY_CONTROL_EVENT);
+}
+
+// Time to sound of each note on, from arrival to the 8254 write, summed.
+static unsigned long g_sound_total = 0;
+static unsigned long g_sound_notes = 0;
+
+static void timed_note_on(char chan, char key, char vel) {
+    on_midi_note_on(chan, key, vel);
+    if (vel) {
+        g_sound_total += synth_note_latency(0);
+        ++g_sound_notes;
+    }
+}
+
+// Feed the controller flood to the synth while the main loop makes slow
+// passes, charging each bend and controller its estimated cost; return the
+// longest time to sound of a note on, and set the mean.
+static uint16_t flood_time_to_sound(unsigned long len, unsigned char priority,
+                                    double* mean, eventq_stats_t* stats) {
+    hal_host_reset();
+    hal_host_set_isr(isr_high);
+    system_init();
+    eventq_set_priority(priority);
+    midi_register_event_handler(EVT_CHAN_PITCH_BEND, costly_bend);
+    midi_register_event_handler(EVT_CHAN_CONTROL_CHANGE,
+                                costly_control_change);
+    midi_register_event_handler(EVT_CHAN_NOTE_ON, timed_note_on);
+    g_sound_total = 0;
+    g_sound_notes = 0;
+    hal_host_usart_feed_timed(g_stream, len, MIDI_TCY_PER_BYTE);
+    while (!hal_host_usart_done()) {
+        sched_run();
+        HAL_DELAY_MS(RX_SLOW_PASS_MS);
+    }
+    sched_run();
+    eventq_get_stats(stats);
+    *mean = g_sound_notes ? (double) g_sound_total / g_sound_notes : 0;
+    return synth_note_latency(1);
+}
+
+// Time to sound under a controller flood, with the notes dispatched ahead
+// of continuous data and, for comparison, in arrival order: a note on that
+// comes in behind a backlog of bends waits for all of it in arrival order,
+// and for none of it with priority. The worst case is a note that arrives
+// just after a pass, ahead of any backlog, so it is the mean that shows
+// the wait.
+static int bench_priority(void) {
+    const unsigned long len = make_flood(g_stream, RX_REPLAY_LEN / 4, 16);
+    eventq_stats_t stats;
+    eventq_stats_t ordered_stats;
+    double mean = 0;
+    double ordered_mean = 0;
+    int errors = 0;
+
+    const uint16_t ordered = flood_time_to_sound(len, 0, &ordered_mean,
+                                                 &ordered_stats);
+    const uint16_t first = flood_time_to_sound(len, 1, &mean, &stats);
+    if (stats.dropped || ordered_stats.dropped || mean >= ordered_mean ||
+        first > 1000 * RX_SLOW_PASS_MS + 1000) {
+        fprintf(stderr, "priority: time to sound %.0f us, %.0f us in "
+                "arrival order, %lu dropped\n", mean, ordered_mean,
+                stats.dropped);
+        ++errors;
+    }
+
+    report("controller flood, time to sound, mean", mean, "us");
+    report("  in arrival order", ordered_mean, "us");
+    report("  worst", first, "us");
+    report("  in arrival order", ordered, "us");
+    report("  messages dispatched", stats.events - stats.coalesced, "");
+    report("  in arrival order",
+           ordered_stats.events - ordered_stats.coalesced, "");
+    return errors;
+}
+
+/*
+ * Many independent parsers on many threads. Each thread owns a share of the
+ * streams and feeds them in small interleaved chunks, so any state leaking
+ * between parser instances (or threads) would corrupt the results.
+ */
+
+static unsigned char g_parallel_streams[PARALLEL_STREAMS][PARALLEL_STREAM_LEN];
+static unsigned long g_parallel_lens[PARALLEL_STREAMS];
+static unsigned long g_parallel_expected[PARALLEL_STREAMS];
+static unsigned long g_parallel_actual[PARALLEL_STREAMS];
+static midi_parser_t g_parallel_parsers[PARALLEL_STREAMS];
+
+// Fold decoded events into a running checksum.
+static unsigned long fold_events(unsigned long sum, const midi_event_t* evt,
+                                 size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        sum = sum * 31 + evt[i].type;
+        sum = sum * 31 + evt[i].channel;
+        sum = sum * 31 + evt[i].data1;
+        sum = sum * 31 + evt[i].data2;
+    }
+    return sum;
+}
+
+static void* parallel_worker(void* arg) {
+    const unsigned long first = (unsigned long) arg;
+    midi_event_t events[PARALLEL_CHUNK];
+
+    for (unsigned long i = first; i < PARALLEL_STREAMS; i += PARALLEL_THREADS) {
+        midi_parser_init(&g_parallel_parsers[i]);
+        g_parallel_actual[i] = 0;
+    }
+    for (unsigned long pos = 0; pos < PARALLEL_STREAM_LEN;
+         pos += PARALLEL_CHUNK) {
+        for (unsigned long i = first; i < PARALLEL_STREAMS;
+             i += PARALLEL_THREADS) {
+            if (pos >= g_parallel_lens[i]) {
+                continue;
+            }
+            const unsigned long left = g_parallel_lens[i] - pos;
+            const size_t n = midi_parser_receive_buffer(
+                &g_parallel_parsers[i], &g_parallel_streams[i][pos],
+                left < PARALLEL_CHUNK ? left : PARALLEL_CHUNK,
+                events, PARALLEL_CHUNK);
+            g_parallel_actual[i] = fold_events(g_parallel_actual[i],
+                                               events, n);
+        }
+    }
+    return 0;
+}
+
+static int bench_parallel_parsers(void) {
+    static midi_event_t events[PARALLEL_STREAM_LEN];
+    pthread_t threads[PARALLEL_THREADS];
+    midi_parser_t reference;
+    int errors = 0;
+
+    // Expected results, one stream at a time on a single parser.
+    for (unsigned long i = 0; i < PARALLEL_STREAMS; ++i) {
+        g_parallel_lens[i] = make_stream_seeded(g_parallel_streams[i],
+                                                PARALLEL_STREAM_LEN, i + 1);
+        midi_parser_init(&reference);
+        const size_t n = midi_parser_receive_buffer(
+            &reference, g_parallel_streams[i], g_parallel_lens[i],
+            events, PARALLEL_STREAM_LEN);
+        g_parallel_expected[i] = fold_events(0, events, n);
+    }
+
+    const double start = now();
+    for (unsigned long t = 0; t < PARALLEL_THREADS; ++t) {
+        pthread_create(&threads[t], 0, parallel_worker, (void*) t);
+    }
+    for (unsigned long t = 0; t < PARALLEL_THREADS; ++t) {
+        pthread_join(threads[t], 0);
+    }
+    const double elapsed = now() - start;
+
+    unsigned long mismatches = 0;
+    for (unsigned long i = 0; i < PARALLEL_STREAMS; ++i) {
+        if (g_parallel_actual[i] != g_parallel_expected[i]) {
+            ++mismatches;
+        }
+    }
+
+    report("parallel parsers, streams", PARALLEL_STREAMS, "");
+    report("  threads", PARALLEL_THREADS, "");
+    report("  streams parsed per second", PARALLEL_STREAMS / elapsed,
+           "streams/s");
+    report("  streams that differ from serial parsing", mismatches, "");
+    if (mismatches) {
+        fprintf(stderr, "parallel parsers: %lu streams differ\n",
+                mismatches);
+        ++errors;
+    }
+    return errors;
+}
+
+
+int main(int argc, char** argv) {
+    int errors = 0;
+
+    bench_parser_null();
+    errors += check_parser_equivalence();
+    errors += check_system_common();
+    errors += bench_parser_buffer();
+    errors += bench_parallel_parsers();
+    errors += bench_sysex_dump();
+    bench_parser_synth();
+    errors += bench_note_on();
+    errors += bench_timer_writes();
+    errors += bench_8254_chips();
+    errors += bench_pitch_divisor();
+    errors += check_8254_readback();
+    errors += check_tunings();
+    errors += check_pitch_pipeline();
+    errors += bench_glide();
+    errors += bench_voices();
+    errors += check_note_stack();
+    errors += bench_modulation();
+    errors += bench_dac();
+    errors += bench_display();
+    errors += bench_scheduler();
+    errors += bench_midi_budget();
+    errors += bench_clock();
+    errors += check_watchdog();
+    errors += bench_rx_ring();
+    errors += bench_rx_errors();
+    errors += bench_event_queue();
+    errors += bench_event_queue_sysex();
+    errors += bench_priority();
+
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
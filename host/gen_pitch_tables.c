@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Generates pitch_tables.c, the 8254 divisor tables used by pitch.c, for
+ * the 8254 clock configured in config.h. Run on the build host (see the
+ * 'tables' target in host/Makefile-host.mk); writes to standard output.
+ */
+#include <math.h>
+#include <stdio.h>
+#include "config.h"
+#include "pitch.h"
+
+// Reference pitch: MIDI note 69 (A4) is 440 Hz.
+#define A4_NOTE 69
+#define A4_HZ 440.0
+
+static const char* NOTE_NAMES[12] = {
+    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+
+static double note_hz(int note) {
+    return A4_HZ * pow(2.0, (note - A4_NOTE) / 12.0);
+}
+
+
+// Frequency of a pitch (see pitch.h.)
+static double pitch_hz(double pitch) {
+    return note_hz(0) * pow(2.0, pitch / PITCH_STEPS_PER_OCTAVE);
+}
+
+
+int main(int argc, char** argv) {
+    const double clock = INTEL8254_CLOCK_HZ;
+    int min_note = 0;
+
+    // The table starts at the lowest note whose divisor fits in 16 bits.
+    while (lround(clock / note_hz(min_note)) > 0xffff) {
+        ++min_note;
+    }
+    const double min_pitch = min_note * PITCH_STEPS_PER_SEMITONE;
+
+    printf("/**\n"
+           " * Copyright (C) 2018 Thomas R. Dial\n"
+           " * All Rights Reserved\n"
+           " *\n"
+           " * Pitch tables for an 8254 clock of %d Hz (see pitch.h.)\n"
+           " *\n"
+           " * GENERATED by host/gen_pitch_tables.c from config.h; do not "
+           "edit.\n"
+           " */\n"
+           "#include \"pitch.h\"\n\n", INTEL8254_CLOCK_HZ);
+
+    printf("const pitch_t PITCH_MIN = %d << PITCH_FRACTION_BITS;"
+           "  // %s%d, %.2f Hz\n\n", min_note, NOTE_NAMES[min_note % 12],
+           min_note / 12 - 1, note_hz(min_note));
+
+    printf("const uint16_t PITCH_EXP_TABLE[PITCH_EXP_SIZE] = {\n");
+    const int per_semitone = PITCH_STEPS_PER_SEMITONE >> PITCH_EXP_BITS;
+    long previous = 0;
+    for (int i = 0; i < PITCH_EXP_SIZE; ++i) {
+        const double pitch = min_pitch + (i << PITCH_EXP_BITS);
+        const long divisor = lround(clock / pitch_hz(pitch));
+        if (i && previous - divisor > 255) {
+            fprintf(stderr, "PITCH_EXP_TABLE steps exceed 255; reduce "
+                    "PITCH_EXP_BITS\n");
+            return 1;
+        }
+        previous = divisor;
+        if (i % per_semitone == 0) {
+            char name[16];
+            const int note = min_note + i / per_semitone;
+            snprintf(name, sizeof(name), "%s%d", NOTE_NAMES[note % 12],
+                     note / 12 - 1);
+            printf("    // %s\n", name);
+        }
+        printf("%s%5ld%s", (i % 8) ? " " : "    ", divisor,
+               (i == PITCH_EXP_SIZE - 1) ? "\n" :
+               (i % 8 == 7) ? ",\n" : ",");
+    }
+    printf("};\n\n");
+
+    printf("const unsigned char PITCH_OCTAVE[128] = {\n");
+    for (int semitone = 0; semitone < 128; ++semitone) {
+        printf("%s%2d%s", (semitone % 12) ? " " : "    ", semitone / 12,
+               (semitone == 127) ? "\n" :
+               (semitone % 12 == 11) ? ",\n" : ",");
+    }
+    printf("};\n");
+    return 0;
+}
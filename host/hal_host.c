@@ -0,0 +1,976 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Linux backend for the hardware abstraction layer: a simulation of the
+ * DIAL-1 board that is good enough to run the firmware modules on a PC.
+ */
+#include "hal_host.h"
+#include <string.h>
+
+// Instruction cycles charged for each kind of operation on the target.
+#define TCY_PORT_BIT    1   // BSF / BCF on a port pin.
+#define TCY_PORT_BYTE   2   // MOVFF into a port register.
+#define TCY_RX_READY    2   // BTFSS on RCIF plus the branch.
+#define TCY_RX_READ     2   // MOVFF out of RCREG.
+#define TCY_SPI_SHIFT   8   // 8 SCK periods at Fosc / 4.
+#define TCY_ISR_ENTRY   10  // Vectoring, context save and restore, RETFIE.
+
+// Depth of the USART receive FIFO on the PIC18.
+#define RX_FIFO_DEPTH   2
+
+// Status byte returned by the 8254 read-back command.
+#define STATUS_OUT        0x80
+#define STATUS_NULL_COUNT 0x40
+
+
+// Counters on the simulated bus: four 8254s behind the chip select
+// decoder, whichever of them the firmware is built to use.
+#define BUS_CHIPS     4
+#define BUS_COUNTERS  (3 * BUS_CHIPS)
+
+// State of the simulated board.
+static hal_host_stats_t g_stats;
+static hal_host_8254_counter_t g_counters[BUS_COUNTERS];
+
+// Counting state of each 8254 counter, in mode 3 (square wave.) The count
+// in use runs a high half of (n + 1) / 2 clocks and a low half of n / 2;
+// a count written while counting takes over at the end of the current
+// half. Latched status and count wait to be read by RD strobes.
+typedef struct counter_sim {
+    unsigned long n;              // Count in use; 0 while stopped.
+    unsigned long pending;        // Count written, not yet in use; or 0.
+    unsigned long long half;      // Clock at which the current half began.
+    unsigned char out;            // Level of the current half.
+    unsigned char status_latched;
+    unsigned char status;
+    unsigned char count_latched;  // Bytes of latched count left to read.
+    unsigned int count;
+    unsigned char msb_read_next;  // Next unlatched read is the MSB.
+} counter_sim_t;
+
+static counter_sim_t g_counter_sim[BUS_COUNTERS];
+
+static unsigned char g_bus_data = 0;
+static unsigned char g_bus_a0 = 0;
+static unsigned char g_bus_a1 = 0;
+static unsigned char g_bus_cs = 1;
+static unsigned char g_bus_chip = 0;    // Decoder input: the chip selected.
+static unsigned char g_bus_wr = 1;
+static unsigned char g_bus_rd = 1;
+static unsigned char g_bus_input = 1;   // Data port direction (TRIS.)
+static unsigned char g_bus_in = 0;      // Byte the 8254 drives on a read.
+static unsigned char g_bus_contending = 0;
+
+static unsigned char g_led_note = 0;
+static unsigned char g_led_error = 0;
+
+// MCP4822s, each with its own chip select: the bits shifted in since CS
+// fell, and the code latched into each channel when it rose.
+#define DAC_CHIPS_MAX 3
+static unsigned char g_dac_cs[DAC_CHIPS_MAX];
+static unsigned long g_dac_shift[DAC_CHIPS_MAX];
+static unsigned char g_dac_bits[DAC_CHIPS_MAX];
+static unsigned int g_dac_code[2 * DAC_CHIPS_MAX];
+
+// SSP: the time the byte being shifted out completes, and the interrupt
+// flag and enable.
+static unsigned char g_spi_busy = 0;
+static unsigned long long g_spi_done = 0;
+static unsigned char g_spi_pending = 0;
+static unsigned char g_spi_irq_enabled = 0;
+static unsigned long g_spi_clears = 0;
+
+// HD44780: it powers up in 8-bit mode, with the low four data lines not
+// connected, and takes a byte as two nibbles once in 4-bit mode. Each
+// instruction keeps it busy for a while, from when it is taken; the busy
+// flag is never read, so a nibble that arrives before then is counted as
+// a violation, as is an E pulse shorter than the 450 ns it needs.
+#define LCD_DDRAM_SIZE    0x80
+#define TCY_LCD_POWER_ON  (40 * HAL_HOST_TCY_PER_MS)
+#define TCY_LCD_FIRST     (4100 * HAL_HOST_TCY_PER_MS / 1000)
+#define TCY_LCD_EXEC      (37 * HAL_HOST_TCY_PER_MS / 1000)
+#define TCY_LCD_HOME      (1520 * HAL_HOST_TCY_PER_MS / 1000)
+#define TCY_LCD_E_PULSE   2
+static char g_lcd_ddram[LCD_DDRAM_SIZE];
+static unsigned char g_lcd_address = 0;
+static unsigned char g_lcd_4bit = 0;
+static unsigned char g_lcd_high = 0;      // High nibble held, for 4-bit.
+static unsigned char g_lcd_have_high = 0;
+static unsigned char g_lcd_first = 1;     // No instruction taken yet.
+static unsigned char g_lcd_on = 0;
+static unsigned char g_lcd_data = 0;
+static unsigned char g_lcd_rs = 0;
+static unsigned char g_lcd_e = 0;
+static unsigned long long g_lcd_e_rise = 0;
+static unsigned long long g_lcd_busy = 0;
+
+static const unsigned char* g_rx_data = 0;
+static unsigned long g_rx_len = 0;
+static unsigned long g_rx_pos = 0;
+
+// Timed reception: the arrival time of the next byte and the FIFO contents.
+static unsigned long g_rx_tcy_per_byte = 0;
+static unsigned long long g_rx_next = 0;
+static unsigned char g_rx_fifo[RX_FIFO_DEPTH];
+static unsigned char g_rx_fifo_ferr[RX_FIFO_DEPTH];
+static unsigned char g_rx_fifo_count = 0;
+
+// Receive error state: OERR stops reception until CREN is cycled, and
+// every 'g_rx_ferr_period'th byte on the wire arrives with a framing error.
+static unsigned char g_rx_oerr = 0;
+static unsigned long g_rx_ferr_period = 0;
+
+// Control tick timer: its period (zero while it is off), the time of the
+// next tick and the interrupt flag.
+static unsigned long g_tick_period = 0;
+static unsigned long long g_tick_next = 0;
+static unsigned char g_tick_pending = 0;
+static unsigned long g_tick_clears = 0;
+
+// Clock timer (Timer1): when it started (or zero while it is off), when it
+// next overflows, and the interrupt flag. It counts every fourth Tcy.
+#define CLOCK_TCY_PER_COUNT 4
+#define CLOCK_PERIOD (65536UL * CLOCK_TCY_PER_COUNT)
+static unsigned char g_clock_on = 0;
+static unsigned long long g_clock_start = 0;
+static unsigned long long g_clock_next = 0;
+static unsigned char g_clock_pending = 0;
+static unsigned long g_clock_clears = 0;
+
+// Interrupt state.
+static void (*g_isr)(void) = 0;
+static unsigned char g_irq_enabled = 0;
+static unsigned char g_rx_irq_enabled = 0;
+static unsigned char g_in_isr = 0;
+
+
+// Return nonzero if an enabled interrupt source is pending.
+static unsigned char irq_pending(void) {
+    return (g_rx_irq_enabled && g_rx_fifo_count) || g_tick_pending ||
+           (g_spi_irq_enabled && g_spi_pending) || g_clock_pending;
+}
+
+// Run the interrupt handler if an enabled interrupt is pending.
+static void service_interrupts(void) {
+    while (g_isr && g_irq_enabled && !g_in_isr && irq_pending()) {
+        const unsigned long rx_bytes = g_stats.rx_bytes;
+        const unsigned long tick_clears = g_tick_clears;
+        const unsigned long spi_clears = g_spi_clears;
+        const unsigned long clock_clears = g_clock_clears;
+        g_in_isr = 1;
+        ++g_stats.isr_calls;
+        g_stats.cycles += TCY_ISR_ENTRY;
+        g_isr();
+        g_in_isr = 0;
+        if (g_stats.rx_bytes == rx_bytes && g_tick_clears == tick_clears &&
+            g_spi_clears == spi_clears && g_clock_clears == clock_clears) {
+            // The handler did not consume anything; don't spin forever.
+            break;
+        }
+    }
+}
+
+// Deliver the next byte on the wire into the receive FIFO. As on the PIC18,
+// a byte that completes while the FIFO is full sets OERR, and nothing more
+// is received until OERR is cleared.
+static void rx_arrive(void) {
+    const unsigned char byte = g_rx_data[g_rx_pos++];
+    const unsigned char ferr =
+        g_rx_ferr_period && (g_rx_pos % g_rx_ferr_period) == 0;
+    if (!g_rx_oerr && g_rx_fifo_count < RX_FIFO_DEPTH) {
+        g_rx_fifo[g_rx_fifo_count] = byte;
+        g_rx_fifo_ferr[g_rx_fifo_count] = ferr;
+        ++g_rx_fifo_count;
+    } else {
+        g_rx_oerr = 1;
+        ++g_stats.rx_lost;
+    }
+    g_rx_next += g_rx_tcy_per_byte;
+}
+
+// Events that charge() delivers.
+#define EVENT_NONE  0
+#define EVENT_RX    1   // A byte arrives.
+#define EVENT_TICK  2   // The control tick falls due.
+#define EVENT_SPI   3   // The SSP finishes shifting out a byte.
+#define EVENT_CLOCK 4   // The clock timer overflows.
+
+// Advance simulated time by 'tcy' cycles of mainline work. Bytes that
+// arrive, ticks that fall due, SPI transfers that complete and clock
+// overflows in the meantime are delivered in order, and the interrupt
+// handler runs as they do; time spent in the handler stretches the
+// interval.
+static void charge(unsigned long tcy) {
+    unsigned long long end = g_stats.cycles + tcy;
+    for (;;) {
+        // The earliest event due by the end; on a tie, a byte arriving
+        // comes first.
+        unsigned char event = EVENT_NONE;
+        unsigned long long at = end + 1;
+        if (g_rx_tcy_per_byte && g_rx_pos < g_rx_len && g_rx_next < at) {
+            event = EVENT_RX;
+            at = g_rx_next;
+        }
+        if (g_tick_period && g_tick_next < at) {
+            event = EVENT_TICK;
+            at = g_tick_next;
+        }
+        if (g_spi_busy && g_spi_done < at) {
+            event = EVENT_SPI;
+            at = g_spi_done;
+        }
+        if (g_clock_on && g_clock_next < at) {
+            event = EVENT_CLOCK;
+            at = g_clock_next;
+        }
+        if (event == EVENT_NONE) {
+            break;
+        }
+        if (at > g_stats.cycles) {
+            g_stats.cycles = at;
+        }
+        if (event == EVENT_RX) {
+            rx_arrive();
+        } else if (event == EVENT_TICK) {
+            g_tick_pending = 1;
+            g_tick_next += g_tick_period;
+            ++g_stats.ticks;
+        } else if (event == EVENT_SPI) {
+            g_spi_busy = 0;
+            g_spi_pending = 1;
+        } else {
+            g_clock_pending = 1;
+            g_clock_next += CLOCK_PERIOD;
+            ++g_stats.clock_overflows;
+        }
+        const unsigned long long before = g_stats.cycles;
+        service_interrupts();
+        end += g_stats.cycles - before;
+    }
+    if (end > g_stats.cycles) {
+        g_stats.cycles = end;
+    }
+}
+
+
+// The 8254 clock, counted from power-up.
+static unsigned long long clock_now(void) {
+    return g_stats.cycles * INTEL8254_CLOCK_HZ / (_XTAL_FREQ / 4);
+}
+
+// Length in clocks of a half cycle at a given output level.
+static unsigned long half_length(unsigned long n, unsigned char out) {
+    return out ? (n + 1) / 2 : n / 2;
+}
+
+// Bring a counter up to the present clock.
+static void counter_run(counter_sim_t* sim) {
+    const unsigned long long now = clock_now();
+    if (sim->n == 0 || sim->half > now) {
+        return;
+    }
+    if (sim->n == 1 && !sim->pending) {
+        // A count of one has no low half; the output stays high.
+        sim->out = 1;
+        sim->half = now;
+        return;
+    }
+    // Skip whole periods of a steady count, then step half by half.
+    if (!sim->pending && sim->out) {
+        sim->half += (now - sim->half) / sim->n * sim->n;
+    }
+    for (;;) {
+        const unsigned long length = half_length(sim->n, sim->out);
+        if (sim->half + length > now) {
+            break;
+        }
+        sim->half += length;
+        sim->out = !sim->out;
+        if (sim->pending) {
+            sim->n = sim->pending;
+            sim->pending = 0;
+        }
+    }
+}
+
+// Value of the counting element: it counts down by two each clock through
+// each half, from the count rounded down to even.
+static unsigned int counter_value(const counter_sim_t* sim) {
+    if (sim->n == 0) {
+        return 0;
+    }
+    const unsigned long elapsed = (unsigned long) (clock_now() - sim->half);
+    const unsigned long start = sim->n & ~1UL;
+    return (unsigned int) (start > 2 * elapsed ? start - 2 * elapsed : 2);
+}
+
+// A complete count has been written to a counter.
+static void counter_load(unsigned char timer, unsigned long n) {
+    counter_sim_t* const sim = &g_counter_sim[timer];
+    g_counters[timer].loaded_at = g_stats.cycles;
+    if (n == 0) {
+        n = 0x10000;
+    }
+    counter_run(sim);
+    if (sim->n == 0) {
+        // Stopped by a control word: counting starts with the next clock,
+        // output high.
+        sim->n = n;
+        sim->half = clock_now() + 1;
+        sim->out = 1;
+    } else {
+        sim->pending = n;
+    }
+}
+
+// Read-back status byte of a counter.
+static unsigned char counter_status(unsigned char timer) {
+    const counter_sim_t* const sim = &g_counter_sim[timer];
+    const hal_host_8254_counter_t* const c = &g_counters[timer];
+    return (sim->out ? STATUS_OUT : 0) |
+           ((sim->n == 0 || sim->pending) ? STATUS_NULL_COUNT : 0) |
+           (unsigned char) (c->rw << 4) | (unsigned char) (c->mode << 1);
+}
+
+// Latch the count of a counter, to be read in its read/write format.
+static void counter_latch(unsigned char timer) {
+    counter_sim_t* const sim = &g_counter_sim[timer];
+    if (!sim->count_latched) {
+        sim->count = counter_value(sim);
+        sim->count_latched = (g_counters[timer].rw == 3) ? 2 : 1;
+    }
+}
+
+// Latch the byte on the data bus into the register addressed by A1:A0, of
+// the chip addressed by the decoder. Counters are numbered across chips.
+static void bus_write_strobe(void) {
+    const unsigned char reg = (unsigned char) ((g_bus_a1 << 1) | g_bus_a0);
+    const unsigned char base = (unsigned char) (3 * g_bus_chip);
+    const unsigned char addr = (unsigned char) (base + reg);
+    const unsigned char byte = g_bus_data;
+
+    ++g_stats.bus_writes;
+
+    if (reg == 3) {
+        // Control word. Counter select in bits 7-6; 3 is the read-back
+        // command, and a read/write format of 0 is the counter latch
+        // command. Neither disturbs counting.
+        const unsigned char select = (byte >> 6) & 0x3;
+        const unsigned char sc = (unsigned char) (base + select);
+        const unsigned char rw = (byte >> 4) & 0x3;
+        if (select == 3) {
+            ++g_stats.latch_commands;
+            for (unsigned char t = base; t < base + 3; ++t) {
+                if (!(byte & (2 << (t - base)))) {
+                    continue;
+                }
+                counter_run(&g_counter_sim[t]);
+                if (!(byte & 0x10) && !g_counter_sim[t].status_latched) {
+                    g_counter_sim[t].status = counter_status(t);
+                    g_counter_sim[t].status_latched = 1;
+                }
+                if (!(byte & 0x20)) {
+                    counter_latch(t);
+                }
+            }
+            return;
+        }
+        if (rw == 0) {
+            ++g_stats.latch_commands;
+            counter_run(&g_counter_sim[sc]);
+            counter_latch(sc);
+            return;
+        }
+
+        // A control word stops the counter, with its output high, until a
+        // count is written. If the output was low, that is an edge out of
+        // place: an audible click.
+        counter_sim_t* const sim = &g_counter_sim[sc];
+        ++g_stats.control_words;
+        counter_run(sim);
+        if (sim->n && !sim->out) {
+            ++g_counters[sc].forced_edges;
+        }
+        sim->n = 0;
+        sim->pending = 0;
+        sim->out = 1;
+        sim->status_latched = 0;
+        sim->count_latched = 0;
+        sim->msb_read_next = 0;
+        g_counters[sc].rw = rw;
+        g_counters[sc].mode = (byte >> 1) & 0x7;
+        g_counters[sc].msb_next = 0;
+        return;
+    }
+
+    hal_host_8254_counter_t* const c = &g_counters[addr];
+    switch (c->rw) {
+        case 1:
+            // LSB only; the MSB of the count is zero.
+            c->divisor = byte;
+            ++c->loads;
+            counter_load(addr, c->divisor);
+            break;
+
+        case 2:
+            // MSB only; the LSB of the count is zero.
+            c->divisor = (unsigned int) byte << 8;
+            ++c->loads;
+            counter_load(addr, c->divisor);
+            break;
+
+        case 3:
+            // LSB followed by MSB.
+            if (!c->msb_next) {
+                c->lsb = byte;
+                c->msb_next = 1;
+            } else {
+                c->divisor = ((unsigned int) byte << 8) | c->lsb;
+                c->msb_next = 0;
+                ++c->loads;
+                counter_load(addr, c->divisor);
+            }
+            break;
+    }
+}
+
+// Drive the byte that a read of the register addressed by A1:A0 returns:
+// latched status first, then a latched count, else the live count.
+static void bus_read_strobe(void) {
+    const unsigned char reg = (unsigned char) ((g_bus_a1 << 1) | g_bus_a0);
+    const unsigned char addr = (unsigned char) (3 * g_bus_chip + reg);
+
+    ++g_stats.bus_reads;
+    g_bus_in = 0xff;
+    if (reg == 3) {
+        return;
+    }
+
+    counter_sim_t* const sim = &g_counter_sim[addr];
+    const unsigned char rw = g_counters[addr].rw;
+    counter_run(sim);
+    if (sim->status_latched) {
+        g_bus_in = sim->status;
+        sim->status_latched = 0;
+        return;
+    }
+
+    unsigned int count = sim->count;
+    unsigned char msb = 0;
+    if (sim->count_latched) {
+        msb = (rw == 2) || (rw == 3 && sim->count_latched == 1);
+        --sim->count_latched;
+    } else {
+        count = counter_value(sim);
+        msb = (rw == 2) || (rw == 3 && sim->msb_read_next);
+        sim->msb_read_next = (rw == 3) && !sim->msb_read_next;
+    }
+    g_bus_in = msb ? (unsigned char) (count >> 8) : (unsigned char) count;
+}
+
+
+/****************************************************************************
+ * Simulation control                                                       *
+ ****************************************************************************/
+
+void hal_host_reset(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+    memset(g_counters, 0, sizeof(g_counters));
+    memset(g_counter_sim, 0, sizeof(g_counter_sim));
+    g_bus_data = 0;
+    g_bus_a0 = 0;
+    g_bus_a1 = 0;
+    g_bus_cs = 1;
+    g_bus_chip = 0;
+    g_bus_wr = 1;
+    g_bus_rd = 1;
+    g_bus_input = 1;
+    g_bus_in = 0;
+    g_bus_contending = 0;
+    g_led_note = 0;
+    g_led_error = 0;
+    memset(g_dac_cs, 1, sizeof(g_dac_cs));
+    memset(g_dac_shift, 0, sizeof(g_dac_shift));
+    memset(g_dac_bits, 0, sizeof(g_dac_bits));
+    memset(g_dac_code, 0, sizeof(g_dac_code));
+    g_spi_busy = 0;
+    g_spi_done = 0;
+    g_spi_pending = 0;
+    g_spi_irq_enabled = 0;
+    g_spi_clears = 0;
+    memset(g_lcd_ddram, ' ', sizeof(g_lcd_ddram));
+    g_lcd_address = 0;
+    g_lcd_4bit = 0;
+    g_lcd_high = 0;
+    g_lcd_have_high = 0;
+    g_lcd_first = 1;
+    g_lcd_on = 0;
+    g_lcd_data = 0;
+    g_lcd_rs = 0;
+    g_lcd_e = 0;
+    g_lcd_busy = TCY_LCD_POWER_ON;
+    g_rx_data = 0;
+    g_rx_len = 0;
+    g_rx_pos = 0;
+    g_rx_tcy_per_byte = 0;
+    g_rx_next = 0;
+    g_rx_fifo_count = 0;
+    g_rx_oerr = 0;
+    g_rx_ferr_period = 0;
+    g_tick_period = 0;
+    g_tick_next = 0;
+    g_tick_pending = 0;
+    g_tick_clears = 0;
+    g_clock_on = 0;
+    g_clock_start = 0;
+    g_clock_next = 0;
+    g_clock_pending = 0;
+    g_clock_clears = 0;
+    g_isr = 0;
+    g_irq_enabled = 0;
+    g_rx_irq_enabled = 0;
+    g_in_isr = 0;
+}
+
+void hal_host_usart_feed(const unsigned char* data, unsigned long len) {
+    g_rx_data = data;
+    g_rx_len = len;
+    g_rx_pos = 0;
+    g_rx_tcy_per_byte = 0;
+    g_rx_fifo_count = 0;
+}
+
+void hal_host_usart_feed_timed(const unsigned char* data, unsigned long len,
+                               unsigned long tcy_per_byte) {
+    g_rx_data = data;
+    g_rx_len = len;
+    g_rx_pos = 0;
+    g_rx_tcy_per_byte = tcy_per_byte;
+    g_rx_next = g_stats.cycles + tcy_per_byte;
+    g_rx_fifo_count = 0;
+    g_rx_oerr = 0;
+}
+
+void hal_host_usart_set_framing_errors(unsigned long period) {
+    g_rx_ferr_period = period;
+}
+
+unsigned char hal_host_usart_done(void) {
+    return g_rx_pos >= g_rx_len && g_rx_fifo_count == 0;
+}
+
+void hal_host_set_isr(void (*isr)(void)) {
+    g_isr = isr;
+}
+
+const hal_host_stats_t* hal_host_stats(void) {
+    return &g_stats;
+}
+
+const hal_host_8254_counter_t* hal_host_8254_counter(unsigned char timer) {
+    timer %= BUS_COUNTERS;
+    counter_run(&g_counter_sim[timer]);
+    g_counters[timer].out = g_counter_sim[timer].out;
+    return &g_counters[timer];
+}
+
+unsigned int hal_host_dac(unsigned char channel) {
+    return channel < 2 * DAC_CHIPS_MAX ? g_dac_code[channel] : 0;
+}
+
+char hal_host_lcd_ddram(unsigned char address) {
+    return g_lcd_ddram[address % LCD_DDRAM_SIZE];
+}
+
+unsigned char hal_host_lcd_on(void) {
+    return g_lcd_on;
+}
+
+unsigned char hal_host_led_note(void) {
+    return g_led_note;
+}
+
+
+/****************************************************************************
+ * HAL backend                                                              *
+ ****************************************************************************/
+
+// An 8254 drives the data bus while its chip select and RD are low; so
+// does PORTB while it is an output. Count each time both start to.
+static void bus_check_contention(void) {
+    const unsigned char contending = !g_bus_cs && !g_bus_rd && !g_bus_input;
+    if (contending && !g_bus_contending) {
+        ++g_stats.bus_contention;
+    }
+    g_bus_contending = contending;
+}
+
+void hal_host_gpio_init(void) {
+    charge(8 * TCY_PORT_BYTE + TCY_PORT_BIT);
+    // PORTB and PORTD become outputs, with the 8254 strobes high.
+    g_bus_data = 0;
+    g_bus_input = 0;
+    g_bus_cs = 1;
+    g_bus_wr = 1;
+    g_bus_rd = 1;
+    g_led_note = 0;
+    g_led_error = 0;
+    bus_check_contention();
+}
+
+void hal_host_led_error_set(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    g_led_error = v;
+}
+
+void hal_host_led_note_set(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    g_led_note = v;
+}
+
+void hal_host_usart_open(unsigned char spbrg, unsigned char brgh) {
+    (void) spbrg;
+    (void) brgh;
+    charge(8 * TCY_PORT_BIT);
+}
+
+unsigned char hal_host_usart_rx_ready(void) {
+    charge(TCY_RX_READY);
+    if (g_rx_tcy_per_byte) {
+        return g_rx_fifo_count != 0;
+    }
+    return g_rx_pos < g_rx_len;
+}
+
+unsigned char hal_host_usart_rx_read(void) {
+    unsigned char byte = 0;
+    charge(TCY_RX_READ);
+    if (g_rx_tcy_per_byte) {
+        if (g_rx_fifo_count == 0) {
+            return 0;
+        }
+        byte = g_rx_fifo[0];
+        g_rx_fifo[0] = g_rx_fifo[1];
+        g_rx_fifo_ferr[0] = g_rx_fifo_ferr[1];
+        --g_rx_fifo_count;
+    } else {
+        if (g_rx_pos >= g_rx_len) {
+            return 0;
+        }
+        byte = g_rx_data[g_rx_pos++];
+    }
+    ++g_stats.rx_bytes;
+    return byte;
+}
+
+unsigned char hal_host_usart_rx_ferr(void) {
+    charge(TCY_PORT_BIT);
+    return g_rx_tcy_per_byte && g_rx_fifo_count && g_rx_fifo_ferr[0];
+}
+
+unsigned char hal_host_usart_rx_oerr(void) {
+    charge(TCY_PORT_BIT);
+    return g_rx_oerr;
+}
+
+void hal_host_usart_rx_restart(void) {
+    charge(2 * TCY_PORT_BIT);
+    g_rx_oerr = 0;
+}
+
+void hal_host_usart_rx_irq_set(unsigned char enabled) {
+    charge(TCY_PORT_BIT);
+    g_rx_irq_enabled = enabled;
+    service_interrupts();
+}
+
+void hal_host_spi_open(void) {
+    charge(16);
+    memset(g_dac_cs, 1, sizeof(g_dac_cs));
+    g_spi_busy = 0;
+    g_spi_pending = 0;
+}
+
+void hal_host_spi_send(unsigned char b) {
+    charge(TCY_PORT_BYTE);
+    ++g_stats.spi_bytes;
+    if (g_spi_busy) {
+        ++g_stats.spi_collisions;   // WCOL: the byte is not sent.
+        return;
+    }
+    g_spi_busy = 1;
+    g_spi_done = g_stats.cycles + TCY_SPI_SHIFT;
+    for (unsigned char n = 0; n < DAC_CHIPS_MAX; ++n) {
+        if (!g_dac_cs[n]) {
+            g_dac_shift[n] = (g_dac_shift[n] << 8) | b;
+            g_dac_bits[n] += 8;
+        }
+    }
+}
+
+unsigned char hal_host_spi_done(void) {
+    charge(TCY_PORT_BIT);
+    return g_spi_pending;
+}
+
+void hal_host_spi_clear(void) {
+    charge(TCY_PORT_BIT + TCY_PORT_BYTE);
+    g_spi_pending = 0;
+    ++g_spi_clears;
+}
+
+void hal_host_spi_irq_enable(void) {
+    charge(4 * TCY_PORT_BIT);
+    g_spi_pending = 0;
+    g_spi_irq_enabled = 1;
+}
+
+void hal_host_dac_cs(unsigned char n, unsigned char v) {
+    charge(2 * TCY_PORT_BIT);
+    if (n >= DAC_CHIPS_MAX) {
+        return;
+    }
+    v &= 1;
+    // An MCP4822 latches the last 16 bits shifted in on the rising edge of
+    // CS: the channel in bit 15, and the code in bits 11-0 unless SHDN
+    // (bit 12) is clear. CS rising in mid-transfer loses the byte.
+    if (!g_dac_cs[n] && v && g_dac_bits[n] >= 16 && !g_spi_busy) {
+        const unsigned int word = (unsigned int) (g_dac_shift[n] & 0xffff);
+        const unsigned char channel = (word >> 15) & 1;
+        g_dac_code[2 * n + channel] = (word & 0x1000) ? (word & 0x0fff) : 0;
+        ++g_stats.dac_writes;
+    }
+    if (g_dac_cs[n] && !v) {
+        g_dac_shift[n] = 0;
+        g_dac_bits[n] = 0;
+    }
+    g_dac_cs[n] = v;
+}
+
+void hal_host_8254_bus_init(void) {
+    charge(5 * TCY_PORT_BYTE + TCY_PORT_BIT);
+    g_bus_chip = 0;
+    g_bus_data = 0;
+    g_bus_input = 0;
+    g_bus_rd = 1;
+    bus_check_contention();
+}
+
+void hal_host_8254_data(unsigned char b) {
+    charge(TCY_PORT_BYTE);
+    g_bus_data = b;
+}
+
+void hal_host_8254_a0(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    g_bus_a0 = v & 1;
+}
+
+void hal_host_8254_a1(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    g_bus_a1 = v & 1;
+}
+
+void hal_host_8254_cs(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    g_bus_cs = v & 1;
+    bus_check_contention();
+}
+
+void hal_host_8254_chip(unsigned char n) {
+    charge(2 * TCY_PORT_BIT);
+    g_bus_chip = n & 0x3;
+}
+
+void hal_host_8254_data_input(unsigned char input) {
+    charge(TCY_PORT_BYTE);
+    g_bus_input = input;
+    bus_check_contention();
+}
+
+unsigned char hal_host_8254_read(void) {
+    charge(TCY_PORT_BYTE);
+    // Reads the pins: what the 8254 drives while RD is low, or else the
+    // output latch.
+    if (g_bus_input && !g_bus_rd && !g_bus_cs) {
+        return g_bus_in;
+    }
+    return g_bus_input ? 0xff : g_bus_data;
+}
+
+void hal_host_8254_rd(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    v &= 1;
+    // The 8254 drives the data bus from the falling edge of RD while CS is
+    // low, and steps to the next byte on the rising edge.
+    if (g_bus_rd && !v && !g_bus_cs) {
+        bus_read_strobe();
+    }
+    g_bus_rd = v;
+    bus_check_contention();
+}
+
+void hal_host_8254_wr(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    v &= 1;
+    // The 8254 latches data on the rising edge of WR while CS is low.
+    if (!g_bus_wr && v && !g_bus_cs) {
+        bus_write_strobe();
+    }
+    g_bus_wr = v;
+}
+
+// Carry out an instruction or character write taken by the LCD.
+static void lcd_execute(unsigned char rs, unsigned char b) {
+    unsigned long tcy = g_lcd_first ? TCY_LCD_FIRST : TCY_LCD_EXEC;
+    g_lcd_first = 0;
+    ++g_stats.lcd_bytes;
+    if (rs) {
+        g_lcd_ddram[g_lcd_address] = (char) b;
+        g_lcd_address = (g_lcd_address + 1) % LCD_DDRAM_SIZE;
+    } else if (b & 0x80) {
+        g_lcd_address = b & 0x7f;
+    } else if (b & 0x40) {
+        // Set CGRAM address: no custom characters are simulated.
+    } else if (b & 0x20) {
+        // Function set: DL (bit 4) clear selects 4-bit mode.
+        g_lcd_4bit = !(b & 0x10);
+        g_lcd_have_high = 0;
+    } else if (b & 0x10) {
+        // Cursor or display shift: not simulated.
+    } else if (b & 0x08) {
+        g_lcd_on = (b >> 2) & 1;
+    } else if (b & 0x04) {
+        // Entry mode set: only increment without shift is simulated.
+    } else if (b & 0x02) {
+        g_lcd_address = 0;
+        tcy = TCY_LCD_HOME;
+    } else if (b & 0x01) {
+        memset(g_lcd_ddram, ' ', sizeof(g_lcd_ddram));
+        g_lcd_address = 0;
+        tcy = TCY_LCD_HOME;
+    }
+    g_lcd_busy = g_stats.cycles + tcy;
+}
+
+// The LCD takes the data lines on the falling edge of E.
+static void lcd_strobe(void) {
+    const unsigned char nibble = g_lcd_data & 0x0f;
+    if (!g_lcd_4bit) {
+        if (g_stats.cycles < g_lcd_busy) {
+            ++g_stats.lcd_violations;
+        }
+        lcd_execute(g_lcd_rs, (unsigned char) (nibble << 4));
+        return;
+    }
+    if (!g_lcd_have_high) {
+        if (g_stats.cycles < g_lcd_busy) {
+            ++g_stats.lcd_violations;
+        }
+        g_lcd_high = nibble;
+        g_lcd_have_high = 1;
+        return;
+    }
+    g_lcd_have_high = 0;
+    lcd_execute(g_lcd_rs, (unsigned char) ((g_lcd_high << 4) | nibble));
+}
+
+void hal_host_lcd_init(void) {
+    charge(4 * TCY_PORT_BIT);
+    g_lcd_rs = 0;
+    g_lcd_e = 0;
+}
+
+void hal_host_lcd_nibble(unsigned char n) {
+    // Read-modify-write of the data port, whose low bits are shared with
+    // the 8254 bus.
+    charge(3 * TCY_PORT_BYTE);
+    g_bus_data = (unsigned char) ((g_bus_data & 0xf0) | (n & 0x0f));
+    g_lcd_data = n & 0x0f;
+}
+
+void hal_host_lcd_rs(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    g_lcd_rs = v & 1;
+}
+
+void hal_host_lcd_e(unsigned char v) {
+    charge(TCY_PORT_BIT);
+    v &= 1;
+    if (!g_lcd_e && v) {
+        g_lcd_e_rise = g_stats.cycles;
+    } else if (g_lcd_e && !v) {
+        if (g_stats.cycles - g_lcd_e_rise < TCY_LCD_E_PULSE) {
+            ++g_stats.lcd_violations;
+        }
+        lcd_strobe();
+    }
+    g_lcd_e = v;
+}
+
+void hal_host_tick_open(void) {
+    charge(6 * TCY_PORT_BYTE);
+    g_tick_period = (unsigned long) (_XTAL_FREQ / 4 / TICK_HZ);
+    g_tick_next = g_stats.cycles + g_tick_period;
+    g_tick_pending = 0;
+}
+
+unsigned char hal_host_tick_pending(void) {
+    charge(TCY_PORT_BIT);
+    return g_tick_pending;
+}
+
+unsigned char hal_host_tick_elapsed(void) {
+    charge(TCY_PORT_BYTE);
+    if (!g_tick_period) {
+        return 0;
+    }
+    const unsigned long long since =
+        g_stats.cycles + g_tick_period - g_tick_next;
+    return (unsigned char) ((since % g_tick_period) / 16);
+}
+
+void hal_host_tick_clear(void) {
+    charge(TCY_PORT_BIT);
+    g_tick_pending = 0;
+    ++g_tick_clears;
+}
+
+void hal_host_clock_open(void) {
+    charge(6 * TCY_PORT_BYTE);
+    g_clock_on = 1;
+    g_clock_start = g_stats.cycles;
+    g_clock_next = g_clock_start + CLOCK_PERIOD;
+    g_clock_pending = 0;
+}
+
+unsigned int hal_host_clock_read(void) {
+    charge(2 * TCY_PORT_BYTE);
+    if (!g_clock_on) {
+        return 0;
+    }
+    return (unsigned int) (((g_stats.cycles - g_clock_start) /
+                            CLOCK_TCY_PER_COUNT) & 0xffff);
+}
+
+unsigned char hal_host_clock_overflow(void) {
+    charge(TCY_PORT_BIT);
+    return g_clock_pending;
+}
+
+void hal_host_clock_clear(void) {
+    charge(TCY_PORT_BIT);
+    g_clock_pending = 0;
+    ++g_clock_clears;
+}
+
+void hal_host_irq_set(unsigned char enabled) {
+    charge(TCY_PORT_BIT);
+    g_irq_enabled = enabled;
+    service_interrupts();
+}
+
+void hal_host_delay_cycles(unsigned long tcy) {
+    charge(tcy);
+}
@@ -0,0 +1,218 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Linux backend for the hardware abstraction layer (see hal.h.) The macros
+ * call into a small simulation of the DIAL-1 board: four Intel 8254s behind
+ * a chip select decoder, which decode bus writes into counter loads and
+ * answer reads, a USART that is fed from a memory buffer, an SPI port with
+ * MCP4822 DACs on it, a character LCD, the timer that raises the control tick
+ * and the one that keeps the clock.
+ *
+ * Each HAL operation is charged the number of PIC18 instruction cycles (Tcy)
+ * it costs on the target, so benchmarks can report simulated cycles for the
+ * I/O side of a code path alongside host wall-clock time.
+ */
+#ifndef HAL_HOST_H_INCLUDED_
+#define HAL_HOST_H_INCLUDED_
+
+#include "config.h"
+
+// Instruction cycles per millisecond on the target (Fosc / 4.)
+#define HAL_HOST_TCY_PER_MS (_XTAL_FREQ / 4 / 1000)
+
+// Simulated Intel 8254 counter.
+typedef struct hal_host_8254_counter {
+    unsigned char mode;       // Counter mode (bits 3-1 of the control word.)
+    unsigned char rw;         // Read/write format (bits 5-4.)
+    unsigned char msb_next;   // Nonzero when the next data byte is the MSB.
+    unsigned char lsb;        // LSB held while waiting for the MSB.
+    unsigned int divisor;     // Last complete count loaded.
+    unsigned long loads;      // Number of complete counts loaded.
+    unsigned long long loaded_at; // Time (Tcy) of the last load.
+    unsigned char out;        // Output level (mode 3 is simulated.)
+    unsigned long forced_edges;   // Control words that forced OUT high
+                                  // during its low half (clicks.)
+} hal_host_8254_counter_t;
+
+// Counters maintained by the simulation.
+typedef struct hal_host_stats {
+    unsigned long long cycles;    // Simulated instruction cycles (Tcy.)
+    unsigned long bus_writes;     // 8254 write strobes (any register.)
+    unsigned long control_words;  // 8254 control word writes.
+    unsigned long latch_commands; // 8254 counter latch and read-back writes.
+    unsigned long bus_reads;      // 8254 read strobes.
+    unsigned long bus_contention; // Times an 8254 and PORTB both drove the
+                                  // data bus.
+    unsigned long spi_bytes;      // Bytes shifted out over SPI.
+    unsigned long spi_collisions; // Bytes sent while the SSP was busy.
+    unsigned long dac_writes;     // Codes latched by the DACs.
+    unsigned long lcd_bytes;      // Instructions and characters the LCD took.
+    unsigned long lcd_violations; // Nibbles sent while the LCD was busy, or too
+                                  // short an E pulse.
+    unsigned long rx_bytes;       // Bytes read from the USART.
+    unsigned long rx_lost;        // Bytes lost to overrun (FIFO full or OERR.)
+    unsigned long isr_calls;      // Invocations of the interrupt handler.
+    unsigned long ticks;          // Control ticks raised by the timer.
+    unsigned long clock_overflows; // Overflows of the clock timer.
+} hal_host_stats_t;
+
+
+/*
+ * Simulation control, used by host programs.
+ */
+
+// Reset the simulated board (including statistics) to power-up state.
+void hal_host_reset(void);
+
+// Supply bytes to be "received" by the USART. The buffer is not copied and
+// must outlive its consumption. All bytes are available immediately.
+void hal_host_usart_feed(const unsigned char* data, unsigned long len);
+
+// As above, but bytes arrive on the wire one every 'tcy_per_byte' simulated
+// instruction cycles and pass through the two-byte hardware receive FIFO.
+// A byte that completes while the FIFO is full is lost. Arrivals raise the
+// receive interrupt when it is enabled.
+void hal_host_usart_feed_timed(const unsigned char* data, unsigned long len,
+                               unsigned long tcy_per_byte);
+
+// Make every 'period'th byte of a timed feed arrive with a framing error
+// (FERR set.) Zero disables framing errors.
+void hal_host_usart_set_framing_errors(unsigned long period);
+
+// Return nonzero once every fed byte has arrived and been read.
+unsigned char hal_host_usart_done(void);
+
+// Install the function that plays the role of the high-priority interrupt
+// vector (see main.c on the target.)
+void hal_host_set_isr(void (*isr)(void));
+
+// Return the simulation statistics.
+const hal_host_stats_t* hal_host_stats(void);
+
+// Return the state of a simulated 8254 counter, as of now. Counters are
+// numbered across chips: 3n + c is counter c of chip n (0 to 11.)
+const hal_host_8254_counter_t* hal_host_8254_counter(unsigned char timer);
+
+// Return the code last latched by a DAC channel: 2n for channel A of DAC
+// n, 2n + 1 for channel B (up to three DACs.)
+unsigned int hal_host_dac(unsigned char channel);
+
+// Return the character at an LCD DDRAM address (0x00 to 0x0f for the top
+// row, 0x40 to 0x4f for the bottom), and whether the display is on.
+char hal_host_lcd_ddram(unsigned char address);
+unsigned char hal_host_lcd_on(void);
+
+// Return the current state of the note LED.
+unsigned char hal_host_led_note(void);
+
+
+/*
+ * Backend entry points behind the HAL_xxx macros.
+ */
+
+void hal_host_gpio_init(void);
+void hal_host_led_error_set(unsigned char v);
+void hal_host_led_note_set(unsigned char v);
+
+void hal_host_usart_open(unsigned char spbrg, unsigned char brgh);
+unsigned char hal_host_usart_rx_ready(void);
+unsigned char hal_host_usart_rx_read(void);
+unsigned char hal_host_usart_rx_ferr(void);
+unsigned char hal_host_usart_rx_oerr(void);
+void hal_host_usart_rx_restart(void);
+void hal_host_usart_rx_irq_set(unsigned char enabled);
+
+void hal_host_spi_open(void);
+void hal_host_spi_send(unsigned char b);
+unsigned char hal_host_spi_done(void);
+void hal_host_spi_clear(void);
+void hal_host_spi_irq_enable(void);
+void hal_host_dac_cs(unsigned char n, unsigned char v);
+
+void hal_host_8254_bus_init(void);
+void hal_host_8254_data(unsigned char b);
+void hal_host_8254_a0(unsigned char v);
+void hal_host_8254_a1(unsigned char v);
+void hal_host_8254_cs(unsigned char v);
+void hal_host_8254_chip(unsigned char n);
+void hal_host_8254_wr(unsigned char v);
+void hal_host_8254_rd(unsigned char v);
+void hal_host_8254_data_input(unsigned char input);
+unsigned char hal_host_8254_read(void);
+
+void hal_host_lcd_init(void);
+void hal_host_lcd_nibble(unsigned char n);
+void hal_host_lcd_rs(unsigned char v);
+void hal_host_lcd_e(unsigned char v);
+
+void hal_host_tick_open(void);
+unsigned char hal_host_tick_pending(void);
+void hal_host_tick_clear(void);
+unsigned char hal_host_tick_elapsed(void);
+
+void hal_host_clock_open(void);
+unsigned int hal_host_clock_read(void);
+unsigned char hal_host_clock_overflow(void);
+void hal_host_clock_clear(void);
+
+void hal_host_irq_set(unsigned char enabled);
+void hal_host_delay_cycles(unsigned long tcy);
+
+
+#define HAL_GPIO_INIT()              hal_host_gpio_init()
+#define HAL_LED_ERROR(v)             hal_host_led_error_set(v)
+#define HAL_LED_NOTE(v)              hal_host_led_note_set(v)
+
+#define HAL_USART_OPEN(spbrg, brgh)  hal_host_usart_open((spbrg), (brgh))
+#define HAL_USART_RX_READY()         hal_host_usart_rx_ready()
+#define HAL_USART_RX_READ()          hal_host_usart_rx_read()
+#define HAL_USART_RX_FERR()          hal_host_usart_rx_ferr()
+#define HAL_USART_RX_OERR()          hal_host_usart_rx_oerr()
+#define HAL_USART_RX_RESTART()       hal_host_usart_rx_restart()
+#define HAL_USART_RX_IRQ_ENABLE()    hal_host_usart_rx_irq_set(1)
+#define HAL_USART_RX_IRQ_DISABLE()   hal_host_usart_rx_irq_set(0)
+
+#define HAL_SPI_OPEN()               hal_host_spi_open()
+#define HAL_SPI_SEND(b)              hal_host_spi_send(b)
+#define HAL_SPI_DONE()               hal_host_spi_done()
+#define HAL_SPI_CLEAR()              hal_host_spi_clear()
+#define HAL_SPI_IRQ_ENABLE()         hal_host_spi_irq_enable()
+#define HAL_DAC_CS(n, v)             hal_host_dac_cs(n, v)
+
+#define HAL_8254_BUS_INIT()          hal_host_8254_bus_init()
+#define HAL_8254_DATA(b)             hal_host_8254_data(b)
+#define HAL_8254_A0(v)               hal_host_8254_a0(v)
+#define HAL_8254_A1(v)               hal_host_8254_a1(v)
+#define HAL_8254_CS(v)               hal_host_8254_cs(v)
+#define HAL_8254_CHIP(n)             hal_host_8254_chip(n)
+#define HAL_8254_WR(v)               hal_host_8254_wr(v)
+#define HAL_8254_RD(v)               hal_host_8254_rd(v)
+#define HAL_8254_DATA_IN()           hal_host_8254_data_input(1)
+#define HAL_8254_DATA_OUT()          hal_host_8254_data_input(0)
+#define HAL_8254_READ()              hal_host_8254_read()
+#define HAL_8254_WAIT()              hal_host_delay_cycles(1)
+
+#define HAL_LCD_INIT()               hal_host_lcd_init()
+#define HAL_LCD_NIBBLE(n)            hal_host_lcd_nibble(n)
+#define HAL_LCD_RS(v)                hal_host_lcd_rs(v)
+#define HAL_LCD_E(v)                 hal_host_lcd_e(v)
+
+#define HAL_TICK_OPEN()              hal_host_tick_open()
+#define HAL_TICK_PENDING()           hal_host_tick_pending()
+#define HAL_TICK_CLEAR()             hal_host_tick_clear()
+#define HAL_TICK_ELAPSED()           hal_host_tick_elapsed()
+
+#define HAL_CLOCK_OPEN()             hal_host_clock_open()
+#define HAL_CLOCK_READ()             hal_host_clock_read()
+#define HAL_CLOCK_OVERFLOW()         hal_host_clock_overflow()
+#define HAL_CLOCK_CLEAR()            hal_host_clock_clear()
+
+#define HAL_NOP()                    hal_host_delay_cycles(1)
+#define HAL_DELAY_MS(ms)                                                     \
+        hal_host_delay_cycles((ms) * (unsigned long) HAL_HOST_TCY_PER_MS)
+
+#define HAL_IRQ_ENABLE()             hal_host_irq_set(1)
+#define HAL_IRQ_DISABLE()            hal_host_irq_set(0)
+
+#endif  // HAL_HOST_H_INCLUDED_
@@ -0,0 +1,18 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * The original switch-based MIDI parser (see midi_legacy.c.) Same contract
+ * as the corresponding midi_xxx() functions in midi.h.
+ */
+#ifndef MIDI_LEGACY_H_INCLUDED_
+#define MIDI_LEGACY_H_INCLUDED_
+
+#include "midi.h"
+
+status_t legacy_midi_init();
+status_t legacy_midi_register_event_handler(event_type evt,
+                                            midi_event_callback_t cb);
+status_t legacy_midi_receive_byte(char byte);
+
+#endif  // MIDI_LEGACY_H_INCLUDED_
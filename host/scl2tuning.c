@@ -0,0 +1,294 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Converts Scala tuning files into tuning_tables.c (see tuning.h.)
+ *
+ *   scl2tuning scale.scl[:mapping.kbm] ...
+ *
+ * Each argument becomes one resident tuning, in order. The scale (.scl)
+ * gives the pitches of the scale degrees in cents or as ratios; the
+ * optional keyboard mapping (.kbm) gives which degree each MIDI key plays
+ * and the frequency of a reference key. Without a mapping, consecutive keys
+ * play consecutive degrees, degree 0 is on key 60 and key 69 is 440 Hz.
+ * Keys that a mapping leaves unmapped ('x') keep their equal-tempered
+ * pitch. The file format is described at http://www.huygens-fokker.org/scala/
+ *
+ * The C source is written to standard output; errors go to standard error.
+ */
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "config.h"
+#include "pitch.h"
+
+#define MAX_DEGREES 256
+#define MAX_LINE 256
+
+// Frequency of MIDI key 0, the origin of pitch_t.
+#define KEY0_HZ (440.0 * pow(2.0, -69.0 / 12.0))
+
+// A scale: cents[i] is degree i + 1; the last entry is the period.
+typedef struct scale {
+    char description[MAX_LINE];
+    int count;
+    double cents[MAX_DEGREES];
+} scale_t;
+
+// A keyboard mapping; degree[i] is -1 where the key is unmapped.
+typedef struct mapping {
+    int size;
+    int first_key;
+    int last_key;
+    int middle_key;
+    int reference_key;
+    double reference_hz;
+    int octave_degree;
+    int degree[128];
+} mapping_t;
+
+
+// Read the next line that is not a comment into 'line', without its line
+// ending. Returns 0 at the end of the file.
+static int read_line(FILE* f, char* line) {
+    while (fgets(line, MAX_LINE, f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] != '!') {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+// Parse a pitch: cents if it contains a period, otherwise a ratio.
+static int parse_pitch(const char* text, double* cents) {
+    while (isspace((unsigned char) *text)) {
+        ++text;
+    }
+    const size_t len = strcspn(text, " \t");
+    if (memchr(text, '.', len)) {
+        *cents = strtod(text, NULL);
+        return 1;
+    }
+    char* end = NULL;
+    const double num = strtod(text, &end);
+    double den = 1.0;
+    if (*end == '/') {
+        den = strtod(end + 1, NULL);
+    }
+    if (num <= 0 || den <= 0) {
+        return 0;
+    }
+    *cents = 1200.0 * log2(num / den);
+    return 1;
+}
+
+
+static int load_scale(const char* path, scale_t* s) {
+    char line[MAX_LINE];
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return 0;
+    }
+    int ok = read_line(f, s->description) && read_line(f, line);
+    s->count = ok ? atoi(line) : 0;
+    if (s->count < 1 || s->count > MAX_DEGREES) {
+        fprintf(stderr, "%s: bad number of notes\n", path);
+        ok = 0;
+    }
+    for (int i = 0; ok && i < s->count; ++i) {
+        ok = read_line(f, line) && parse_pitch(line, &s->cents[i]);
+        if (!ok) {
+            fprintf(stderr, "%s: bad pitch for degree %d\n", path, i + 1);
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+
+static void default_mapping(const scale_t* s, mapping_t* m) {
+    m->size = 0;
+    m->first_key = 0;
+    m->last_key = 127;
+    m->middle_key = 60;
+    m->reference_key = 69;
+    m->reference_hz = 440.0;
+    m->octave_degree = s->count;
+}
+
+
+static int load_mapping(const char* path, mapping_t* m) {
+    char line[MAX_LINE];
+    int fields[5];
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return 0;
+    }
+    int ok = 1;
+    for (int i = 0; ok && i < 5; ++i) {
+        ok = read_line(f, line);
+        fields[i] = atoi(line);
+    }
+    ok = ok && read_line(f, line);
+    m->reference_hz = ok ? strtod(line, NULL) : 0;
+    ok = ok && read_line(f, line);
+    m->octave_degree = ok ? atoi(line) : 0;
+    m->size = fields[0];
+    m->first_key = fields[1];
+    m->last_key = fields[2];
+    m->middle_key = fields[3];
+    m->reference_key = fields[4];
+    if (!ok || m->size < 0 || m->size > 128 || m->reference_hz <= 0) {
+        fprintf(stderr, "%s: bad header\n", path);
+        ok = 0;
+    }
+    for (int i = 0; ok && i < m->size; ++i) {
+        // Trailing entries may be omitted; they are unmapped.
+        if (!read_line(f, line)) {
+            m->degree[i] = -1;
+            continue;
+        }
+        const char* p = line;
+        while (isspace((unsigned char) *p)) {
+            ++p;
+        }
+        m->degree[i] = (*p == 'x' || *p == 0) ? -1 : atoi(p);
+    }
+    fclose(f);
+    return ok;
+}
+
+
+// Return the scale degree (counting periods) that a key plays, or 0 and
+// set *mapped to zero if the key is unmapped.
+static long key_degree(const mapping_t* m, int key, int* mapped) {
+    const long offset = key - m->middle_key;
+    *mapped = (key >= m->first_key) && (key <= m->last_key);
+    if (m->size == 0) {
+        return offset;
+    }
+    const long octave = (long) floor((double) offset / m->size);
+    const int index = (int) (offset - octave * m->size);
+    if (m->degree[index] < 0) {
+        *mapped = 0;
+        return 0;
+    }
+    return m->degree[index] + octave * m->octave_degree;
+}
+
+
+static double degree_cents(const scale_t* s, long degree) {
+    const long period = (long) floor((double) degree / s->count);
+    const int index = (int) (degree - period * s->count);
+    const double within = index ? s->cents[index - 1] : 0.0;
+    return period * s->cents[s->count - 1] + within;
+}
+
+
+static void emit_tuning(const char* name, const char* source,
+                        const scale_t* s, const mapping_t* m) {
+    double hz[128];
+    int mapped = 0;
+    const double reference_cents =
+        degree_cents(s, key_degree(m, m->reference_key, &mapped));
+
+    for (int key = 0; key < 128; ++key) {
+        const long degree = key_degree(m, key, &mapped);
+        if (mapped) {
+            hz[key] = m->reference_hz *
+                pow(2.0, (degree_cents(s, degree) - reference_cents) / 1200);
+        } else {
+            hz[key] = KEY0_HZ * pow(2.0, key / 12.0);
+        }
+    }
+
+    printf("// %s\n// (%s)\n", s->description, source);
+    printf("static const tuning_t TUNING_%s = {\n    \"%s\",\n", name, name);
+
+    printf("    {\n");
+    for (int key = 0; key < 128; ++key) {
+        long pitch = lround(12.0 * PITCH_STEPS_PER_SEMITONE *
+                            log2(hz[key] / KEY0_HZ));
+        pitch = pitch < 0 ? 0 : (pitch > PITCH_MAX ? PITCH_MAX : pitch);
+        printf("%s%5ld%s", (key % 8) ? " " : "        ", pitch,
+               (key == 127) ? "\n" : (key % 8 == 7) ? ",\n" : ",");
+    }
+    printf("    },\n    {\n");
+    for (int key = 0; key < 128; ++key) {
+        long divisor = lround(INTEL8254_CLOCK_HZ / hz[key]);
+        divisor = divisor < 1 ? 1 : (divisor > 0xffff ? 0xffff : divisor);
+        printf("%s%5ld%s", (key % 8) ? " " : "        ", divisor,
+               (key == 127) ? "\n" : (key % 8 == 7) ? ",\n" : ",");
+    }
+    printf("    }\n};\n\n");
+}
+
+
+int main(int argc, char** argv) {
+    static char names[MAX_DEGREES][MAX_LINE];
+    const int count = argc - 1;
+
+    if (count < 1 || count > MAX_DEGREES) {
+        fprintf(stderr, "usage: %s scale.scl[:mapping.kbm] ...\n", argv[0]);
+        return 1;
+    }
+
+    printf("/**\n"
+           " * Copyright (C) 2018 Thomas R. Dial\n"
+           " * All Rights Reserved\n"
+           " *\n"
+           " * Resident tuning tables for an 8254 clock of %d Hz (see "
+           "tuning.h.)\n"
+           " *\n"
+           " * GENERATED by host/scl2tuning.c from the Scala files noted "
+           "below; do not\n"
+           " * edit.\n"
+           " */\n"
+           "#include \"tuning.h\"\n\n", INTEL8254_CLOCK_HZ);
+
+    for (int i = 0; i < count; ++i) {
+        char scl[MAX_LINE];
+        scale_t s;
+        mapping_t m;
+
+        // Split "scale.scl:mapping.kbm".
+        snprintf(scl, sizeof(scl), "%s", argv[i + 1]);
+        char* kbm = strchr(scl, ':');
+        if (kbm) {
+            *kbm++ = 0;
+        }
+        if (!load_scale(scl, &s)) {
+            return 1;
+        }
+        default_mapping(&s, &m);
+        if (kbm && !load_mapping(kbm, &m)) {
+            return 1;
+        }
+
+        // The tuning is named after the scale file (less directory and
+        // extension), made into an identifier.
+        const char* base = strrchr(scl, '/');
+        base = base ? base + 1 : scl;
+        char* name = names[i];
+        snprintf(name, MAX_LINE, "%s", base);
+        name[strcspn(name, ".")] = 0;
+        for (char* c = name; *c; ++c) {
+            *c = isalnum((unsigned char) *c) ? toupper((unsigned char) *c)
+                                             : '_';
+        }
+        emit_tuning(name, argv[i + 1], &s, &m);
+    }
+
+    printf("const tuning_t* const TUNINGS[] = {\n");
+    for (int i = 0; i < count; ++i) {
+        printf("    &TUNING_%s%s\n", names[i], (i < count - 1) ? "," : "");
+    }
+    printf("};\n\nconst unsigned char TUNING_COUNT = %d;\n", count);
+    return 0;
+}
@@ -1,103 +1,297 @@
 /**
  * Copyright (C) 2018 Thomas R. Dial
  * All Rights Reserved
- * 
- * Routines for initialization and communicating with an Intel 8254 Timer.
+ *
+ * Routines for initialization and communicating with Intel 8254 Timers.
  */
 
 #include "intel8254.h"
-#include <xc.h>
-#include <delays.h>
 #include "config.h"
+#include "hal.h"
 
-#define INTEL_8254_A0 PORTDbits.RD4
-#define INTEL_8254_A1 PORTDbits.RD5
-#define INTEL_8254_CS PORTDbits.RD6
-#define INTEL_8254_WR PORTDbits.RD7
 
+// Control word fields. Every counter runs in mode 3 (square wave), in which
+// a new count takes effect at the end of the current half cycle, so loading
+// one is glitch free. Writing a control word, on the other hand, stops the
+// counter until a count follows, which is an audible click
+// (README.pitch-bend). So the format is changed on key down (see
+// intel_start_timer()), and otherwise only when a count does not fit it,
+// timed to the output edge (see change_format().)
+#define CW_SELECT_SHIFT 6
+#define CW_RW_SHIFT     4
+#define CW_MODE_3       0b00000110
+#define RW_LATCH        0x0   // Counter latch command.
+#define RW_LSB          0x1   // Count is LSB only; the MSB is zero.
+#define RW_LSB_MSB      0x3   // Count is LSB, then MSB.
 
-// Initialize the Intel 8254 timer to a known state.
+// Read-back command: latch the status (and not the count) of the counters
+// whose bits are set.
+#define CW_READ_BACK_STATUS  0b11100000
+#define RB_COUNTER(counter)  (2 << (counter))
+
+// Reads of the output that change_format() makes while waiting for an
+// edge; enough to see two edges of any count below 256.
+#define EDGE_POLLS 32
+
+// A bus address: the chip select (decoder output) of a chip in bits 3-2,
+// and a register of that chip (counter 0, 1, 2 or the control word, 3) in
+// bits 1-0.
+#define ADDRESS_CHIP_SHIFT  2
+#define ADDRESS_REGISTER    0x3
+#define REGISTER_CONTROL    0x3
+
+// The chip select of each chip, from config.h.
+static const unsigned char CHIP_SELECTS[4] = INTEL8254_CHIP_SELECTS;
+
+// What each counter was last programmed with. A divisor of zero (a count
+// of 65536) is never cached, so a zero shadow also means "not loaded".
+typedef struct counter_shadow {
+    uint16_t divisor;       // Last count loaded.
+    unsigned char rw;       // Format set by the last control word.
+    unsigned char address;  // Bus address of the counter.
+} counter_shadow_t;
+
+static counter_shadow_t g_shadow[INTEL8254_COUNTERS];
+
+
+// Put a bus address on the chip select decoder and A1:A0. Selecting the
+// chip costs the same however many chips there are.
+static void select_address(unsigned char address) {
+    HAL_8254_CHIP(address >> ADDRESS_CHIP_SHIFT);
+    HAL_8254_A0(address & 1);
+    HAL_8254_A1((address >> 1) & 1);
+}
+
+// Select a register of the chip already selected.
+static void select_register(unsigned char reg) {
+    HAL_8254_A0(reg & 1);
+    HAL_8254_A1((reg >> 1) & 1);
+}
+
+// Strobe a byte into the selected register.
+static void write_byte(unsigned char byte) {
+    HAL_8254_DATA(byte);
+    HAL_8254_WR(0);
+    HAL_8254_WAIT();
+    HAL_8254_WR(1);
+}
+
+// Strobe a byte out of the selected register. The data port must be an
+// input.
+static unsigned char read_byte(void) {
+    HAL_8254_RD(0);
+    HAL_8254_WAIT();
+    const unsigned char byte = HAL_8254_READ();
+    HAL_8254_RD(1);
+    return byte;
+}
+
+// Write a command to the control word register of a counter's chip.
+static void write_command(unsigned char timer, unsigned char command) {
+    select_address(g_shadow[timer].address | REGISTER_CONTROL);
+    write_byte(command);
+}
+
+// Set the read/write format of a counter, in mode 3.
+static void write_control_word(unsigned char timer, unsigned char rw) {
+    const unsigned char counter = g_shadow[timer].address & ADDRESS_REGISTER;
+    write_command(timer, (counter << CW_SELECT_SHIFT) |
+                         (rw << CW_RW_SHIFT) | CW_MODE_3);
+    g_shadow[timer].rw = rw;
+    g_shadow[timer].divisor = 0;
+}
+
+// Wait, for a bounded time, until the output of a counter rises. Return
+// nonzero if it did.
+static unsigned char wait_for_rising_edge(unsigned char timer) {
+    unsigned char was_low = 0;
+    for (unsigned char poll = 0; poll < EDGE_POLLS; ++poll) {
+        const unsigned char out = intel_read_status(timer) & INTEL_STATUS_OUT;
+        if (!out) {
+            was_low = 1;
+        } else if (was_low) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Change the format of a counter whose count is about to be written.
+// A control word forces the output high and stops the counter until the
+// count arrives. Just after the output rises that changes nothing audible:
+// the high half is stretched by the time to write the count, rather than a
+// low half being cut short by a spike. A counter in the one-byte format
+// has a period under 256 clocks, so the wait for its edge is short; a
+// longer one is not waited for. Nor is a silent one, at a count of one,
+// whose output stays high.
+static void change_format(unsigned char timer, unsigned char rw) {
+    if (g_shadow[timer].rw == RW_LSB && g_shadow[timer].divisor > 1) {
+        wait_for_rising_edge(timer);
+    }
+    write_control_word(timer, rw);
+}
+
+// Write a count to a counter of the chip already selected, in its format.
+static void write_count(unsigned char timer, uint16_t divisor) {
+    select_register(g_shadow[timer].address & ADDRESS_REGISTER);
+    write_byte((unsigned char) (divisor & 0xff));
+    if (g_shadow[timer].rw == RW_LSB_MSB) {
+        write_byte((unsigned char) (divisor >> 8));
+    }
+    g_shadow[timer].divisor = divisor;
+}
+
+
+// Initialize the Intel 8254 timers to a known state.
 status_t intel_8254_init() {
-    // TODO(tdial): I should not be hard-coding things to use PORTB here;
-    // and port initialization should be taking place outside of this
-    // routine. The way to go probably is to have a configuration header
-    // that defines the data port to use as well as the control lines. 
-    // This could be put into a configuration header file.
-    // Port B is output
-    TRISB = 0;
-
-    // Initial Port B lines are zero.
-    PORTB = 0;
-    
-    // Port D is output
-    TRISD = 0;
-    
-    // Initialize the 8254 to a known state.  CS, low, WR high,
-    // meaning that the chip is selected but not write enabled.
-    // A0, A1 are high, meaning that if a word was written it
+    // The bus pins are assigned by the HAL (hal_pic.h), and the chips on
+    // the bus by config.h. The data port is an output, initially zero,
+    // except while a chip is being read.
+    HAL_8254_BUS_INIT();
+
+    // Initialize the bus to a known state: the chip select decoder
+    // enabled, WR high, meaning that a chip is selected but not write
+    // enabled. A0, A1 are high, meaning that if a word was written it
     // would go to the control register.
-    INTEL_8254_CS = 0; 
-    INTEL_8254_WR = 1; 
-    INTEL_8254_A0 = 1; 
-    INTEL_8254_A1 = 1; 
-     
-    // Write control word
-    for (char timer = 0; timer < 3; ++timer) {
-        const unsigned char control_word = (timer << 6) |
-                                           (0x3 << 4) |
-                                           (0b00000110);
-        PORTB = control_word;
-        INTEL_8254_A0 = 1; // RD4 on the PIC -> A0 on the 8254
-        INTEL_8254_A1 = 1; // RD5 on the PIC -> A1 on the 8254
-
-        // Pulse Write
-        INTEL_8254_WR = 0;
-        NOPWAIT();
-        INTEL_8254_WR = 1;
-        
+    HAL_8254_CHIP(CHIP_SELECTS[0]);
+    HAL_8254_CS(0);
+    HAL_8254_WR(1);
+    HAL_8254_A0(1);
+    HAL_8254_A1(1);
+
+    // Write control word: mode 3, LSB then MSB.
+    for (unsigned char timer = 0; timer < INTEL8254_COUNTERS; ++timer) {
+        const unsigned char chip = timer / 3;
+        g_shadow[timer].address =
+            (CHIP_SELECTS[chip] << ADDRESS_CHIP_SHIFT) | (timer - chip * 3);
+        write_control_word(timer, RW_LSB_MSB);
+
         // Delay before sending next command.
-       __delay_ms(10);
+       HAL_DELAY_MS(10);
     }
-      
+
     return 0;
 }
 
-inline void intel_write_timer(unsigned char timer,
-                              unsigned char lsb,
-                              unsigned char msb) {
-    // The timer must be 0, 1 or 2.
-    timer &= 0x3;
-    if (timer == 3) {
+void intel_write_timer(unsigned char timer,
+                       unsigned char lsb,
+                       unsigned char msb) {
+    if (timer >= INTEL8254_COUNTERS) {
         return;
     }
-    
-    // Set up address for data words
-    switch (timer) {
-        case 0:
-            INTEL_8254_A0 = 0;
-            INTEL_8254_A1 = 0;
-            break;
-        case 1:
-            INTEL_8254_A0 = 1;
-            INTEL_8254_A1 = 0;
-            break;
-        case 2:
-            INTEL_8254_A0 = 0;
-            INTEL_8254_A1 = 1;
-            break;
+
+    // Nothing to do if the counter already has this count.
+    counter_shadow_t* const shadow = &g_shadow[timer];
+    const uint16_t divisor = ((uint16_t) msb << 8) | lsb;
+    if (divisor && divisor == shadow->divisor) {
+        return;
+    }
+
+    // An LSB-only counter can't take a nonzero MSB; it has to go back to
+    // the two-byte format. That only happens when a pitch that started
+    // above about 7.8 kHz (a divisor below 256) falls below it.
+    if (msb && shadow->rw == RW_LSB) {
+        change_format(timer, RW_LSB_MSB);
+    }
+
+    // Write the count: one byte or two, in the counter's format.
+    select_address(shadow->address);
+    write_count(timer, divisor);
+    HAL_8254_WAIT();
+}
+
+
+void intel_write_timers(const uint16_t* divisors) {
+    unsigned char changed[INTEL8254_CHIPS];
+    unsigned char any = 0;
+
+    // Work out which counters change, and reformat any that must be,
+    // before the first load, so that the loads follow one another as
+    // closely as the bus allows.
+    unsigned char timer = 0;
+    for (unsigned char chip = 0; chip < INTEL8254_CHIPS; ++chip) {
+        changed[chip] = 0;
+        for (unsigned char counter = 0; counter < 3; ++counter, ++timer) {
+            const uint16_t divisor = divisors[timer];
+            if (divisor && divisor == g_shadow[timer].divisor) {
+                continue;
+            }
+            if ((divisor >> 8) && g_shadow[timer].rw == RW_LSB) {
+                change_format(timer, RW_LSB_MSB);
+            }
+            changed[chip] |= 1 << counter;
+        }
+        any |= changed[chip];
+    }
+    if (!any) {
+        return;
+    }
+
+    // One transaction per chip: select it once, then load its counters.
+    timer = 0;
+    for (unsigned char chip = 0; chip < INTEL8254_CHIPS; ++chip, timer += 3) {
+        if (!changed[chip]) {
+            continue;
+        }
+        HAL_8254_CHIP(CHIP_SELECTS[chip]);
+        for (unsigned char counter = 0; counter < 3; ++counter) {
+            if (changed[chip] & (1 << counter)) {
+                write_count(timer + counter, divisors[timer + counter]);
+            }
+        }
+    }
+    HAL_8254_WAIT();
+}
+
+
+void intel_start_timer(unsigned char timer,
+                       unsigned char lsb,
+                       unsigned char msb) {
+    if (timer >= INTEL8254_COUNTERS) {
+        return;
+    }
+
+    // Use the one-byte format where the count allows, so that later
+    // updates near this pitch cost a single write.
+    const unsigned char rw = msb ? RW_LSB_MSB : RW_LSB;
+    if (rw != g_shadow[timer].rw) {
+        change_format(timer, rw);
+    }
+    intel_write_timer(timer, lsb, msb);
+}
+
+
+unsigned char intel_read_status(unsigned char timer) {
+    if (timer >= INTEL8254_COUNTERS) {
+        return 0;
+    }
+
+    const unsigned char address = g_shadow[timer].address;
+    write_command(timer, CW_READ_BACK_STATUS |
+                         RB_COUNTER(address & ADDRESS_REGISTER));
+    select_register(address & ADDRESS_REGISTER);
+    HAL_8254_DATA_IN();
+    const unsigned char status = read_byte();
+    HAL_8254_DATA_OUT();
+    return status;
+}
+
+
+uint16_t intel_read_timer(unsigned char timer) {
+    if (timer >= INTEL8254_COUNTERS) {
+        return 0;
+    }
+
+    // Latch the count, then read it in the counter's format.
+    const unsigned char address = g_shadow[timer].address;
+    write_command(timer, ((address & ADDRESS_REGISTER) << CW_SELECT_SHIFT) |
+                         (RW_LATCH << CW_RW_SHIFT));
+    select_register(address & ADDRESS_REGISTER);
+    HAL_8254_DATA_IN();
+    uint16_t count = read_byte();
+    if (g_shadow[timer].rw == RW_LSB_MSB) {
+        count |= (uint16_t) read_byte() << 8;
     }
-    
-    // Write LSB
-    PORTB = lsb;
-    INTEL_8254_WR = 0;
-    NOPWAIT();
-    // TODO(tdial): Figure out actual delays needed.s
-    INTEL_8254_WR = 1;
-    
-    // Write MSB
-    PORTB = msb;
-    INTEL_8254_WR = 0;
-    NOPWAIT();
-    INTEL_8254_WR = 1;
-    NOPWAIT();
+    HAL_8254_DATA_OUT();
+    return count;
 }
@@ -2,33 +2,61 @@
  * Copyright (C) 2018 Thomas R. Dial
  * All Rights Reserved
  * 
- * Routines for initialization and communicating with an Intel 8254 Timer.
+ * Routines for initialization and communicating with Intel 8254 Timers.
+ *
+ * Up to four 8254s share the data bus, each selected through a chip select
+ * decoder (see INTEL8254_CHIPS in config.h.) Their counters are numbered
+ * together: timer 3n + c is counter c of chip n.
  */
 #ifndef INTEL8254_H_INCLUDED_
 #define INTEL8254_H_INCLUDED_
 
+#include <stdint.h>
+#include "config.h"
 #include "status.h"
-#include <xc.h>
 
-// Initialize the Intel 8254 timer to a known state.
+// Number of timers (counters) on the bus.
+#define INTEL8254_COUNTERS (3 * INTEL8254_CHIPS)
+
+// Bits of the status returned by intel_read_status().
+#define INTEL_STATUS_OUT        0x80  // Level of the counter's output.
+#define INTEL_STATUS_NULL_COUNT 0x40  // A count written is not yet in use.
+
+// Initialize the Intel 8254 timers to a known state.
 status_t intel_8254_init();
 
 // Load a new divisor into timer zero for square-wave clock generation.
 //void intel_8254_set_timer0(unsigned char lsb, unsigned char msb);
 
-//#define NOPWAIT() Nop(); Nop(); Nop(); Nop(); Nop();
-
-// Below for 16mhz Master Clock
-// TODO(tdial): Ensure delays are long enough for the 8254.)
-// This defines the delay in cycles needed between operations on the 8254.
-// I suspect that when I moved to 16mhz I didn't do the calculations correctly.
-// This delay must be verified against the data sheet.
-#define NOPWAIT() Nop(); Nop(); Nop(); Nop(); Nop(); Nop(); Nop(); Nop(); Nop(); Nop(); Nop()
-
-
-inline void intel_write_timer(unsigned char timer,
-                              unsigned char lsb,
-                              unsigned char msb);
+// Load a new divisor (LSB, MSB) into a timer, without a glitch.
+// The driver keeps a shadow of each counter: a divisor that is already
+// loaded is not written again, and in the one-byte format (see
+// intel_start_timer()) a count is a single bus write.
+void intel_write_timer(unsigned char timer,
+                       unsigned char lsb,
+                       unsigned char msb);
+
+// As above, for a note that is starting (on key down), where reprogramming
+// the counter does not click: a divisor below 256 switches the counter to
+// the one-byte (LSB only) format, and a larger one back to the two-byte
+// format.
+void intel_start_timer(unsigned char timer,
+                       unsigned char lsb,
+                       unsigned char msb);
+
+// Load new divisors into all INTEL8254_COUNTERS timers, as
+// intel_write_timer() would, with the bus writes back to back so that the
+// counters change together. Any control words needed are written first,
+// then each chip with a change is selected once and its counters loaded.
+void intel_write_timers(const uint16_t* divisors);
+
+// Read the status of a timer with the read-back command; see
+// INTEL_STATUS_xxx. Counting is not disturbed.
+unsigned char intel_read_status(unsigned char timer);
+
+// Latch and read the count of a timer. In mode 3 the count runs
+// down by two through each half cycle. Counting is not disturbed.
+uint16_t intel_read_timer(unsigned char timer);
 
 
 #endif  // INTEL8254_H_INCLUDED_
\ No newline at end of file
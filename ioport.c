@@ -5,26 +5,59 @@
  * Routines for initializing and reading/writing serial I/O.
  */
 #include "ioport.h"
-#include <xc.h>
+#include "clock.h"
 #include "config.h"
+#include "hal.h"
+
+#define RX_RING_MASK (IOPORT_RX_RING_SIZE - 1)
+
+#if (IOPORT_RX_RING_SIZE & RX_RING_MASK) || (IOPORT_RX_RING_SIZE > 128)
+#error "IOPORT_RX_RING_SIZE must be a power of two no larger than 128"
+#endif
+
+
+/**
+ * Receive ring buffer. The indices are free-running; they are masked when
+ * used to address the ring, and their difference is the number of bytes
+ * waiting. The ISR only writes g_rx_head and the consumer only writes
+ * g_rx_tail; both are single bytes, so loads and stores are atomic. Each
+ * byte's arrival time (see clock_now16()) is kept alongside it.
+ */
+static volatile unsigned char g_rx_ring[IOPORT_RX_RING_SIZE];
+static volatile uint16_t g_rx_time[IOPORT_RX_RING_SIZE];
+static volatile unsigned char g_rx_head = 0;
+static volatile unsigned char g_rx_tail = 0;
+
+// Receive statistics; updated by the ISR.
+static volatile ioport_stats_t g_stats;
+
+
+static void clear_stats() {
+    g_stats.rx_bytes = 0;
+    g_stats.rx_overruns = 0;
+    g_stats.rx_framing = 0;
+    g_stats.rx_dropped = 0;
+    g_stats.rx_high_water = 0;
+}
 
 
 status_t ioport_init(unsigned long int baudrate) {
     unsigned long int x = 0;
+    unsigned char brgh = 0;
     x = (_XTAL_FREQ - (baudrate * 64)) / (baudrate * 64);
     if (x > 255) {
         x = (_XTAL_FREQ - (baudrate * 16)) / (baudrate * 16);
-        BRGH = 1;
+        brgh = 1;
     }
     
     if (x < 256) {
-        SPBRG = x;   
-        SYNC = 0;    // Asynchronous mode (clear sync bit to zero.)
-        SPEN = 1;    // Enable serial communication.
-        TRISC7 = 1;  // Configure as RX pin (serial data receive)
-        TRISC6 = 1;  // Configure as TX pin (serial data transmit)
-        CREN = 1;    // Enable reception
-        TXEN = 1;    // Enable transmission
+        g_rx_head = 0;
+        g_rx_tail = 0;
+        clear_stats();
+        
+        // Asynchronous mode, serial port and RX/TX pins enabled.
+        HAL_USART_OPEN(x, brgh);
+        HAL_USART_RX_IRQ_ENABLE();
         return 0;    // Return success
     }
     
@@ -32,12 +65,118 @@ status_t ioport_init(unsigned long int baudrate) {
 }
 
 
+void ioport_rx_isr() {
+    // The bytes in the FIFO are stamped with the time the interrupt is
+    // taken: within a byte time of their arrival.
+    const uint16_t now = clock_now16();
+    
+    // Drain the hardware FIFO completely so that RCIF is clear on return.
+    while (HAL_USART_RX_READY()) {
+        // FERR describes the byte at the top of the FIFO; sample it first.
+        const char framing_error = HAL_USART_RX_FERR();
+        const unsigned char byte = HAL_USART_RX_READ();
+        const unsigned char head = g_rx_head;
+        const unsigned char used = (unsigned char) (head - g_rx_tail);
+        
+        ++g_stats.rx_bytes;
+        
+        if (framing_error) {
+            // The stop bit was missing; the byte is garbage.
+            ++g_stats.rx_framing;
+            continue;
+        }
+        
+        if (used >= IOPORT_RX_RING_SIZE) {
+            // The consumer has fallen too far behind; drop the byte.
+            ++g_stats.rx_dropped;
+            continue;
+        }
+        
+        g_rx_ring[head & RX_RING_MASK] = byte;
+        g_rx_time[head & RX_RING_MASK] = now;
+        g_rx_head = head + 1;
+        
+        if (used >= g_stats.rx_high_water) {
+            g_stats.rx_high_water = used + 1;
+        }
+    }
+    
+    // On overrun the USART stops receiving until CREN is cycled. The FIFO
+    // is empty now, so restart; only the bytes that overflowed are lost.
+    if (HAL_USART_RX_OERR()) {
+        HAL_USART_RX_RESTART();
+        ++g_stats.rx_overruns;
+    }
+}
+
+
+unsigned char ioport_rx_count() {
+    return (unsigned char) g_stats.rx_bytes;
+}
+
+
 char ioport_data_ready() {
-    return RCIF;
+    return g_rx_head != g_rx_tail;
+}
+
+
+unsigned char ioport_available() {
+    return (unsigned char) (g_rx_head - g_rx_tail);
 }
 
 
 char ioport_read() {
-    while (!RCIF);
-    return RCREG;
-}
\ No newline at end of file
+    char byte = 0;
+    while (!ioport_read_nonblocking(&byte));
+    return byte;
+}
+
+
+char ioport_read_nonblocking(char* byte) {
+    const unsigned char tail = g_rx_tail;
+    if (tail == g_rx_head) {
+        return 0;
+    }
+    *byte = g_rx_ring[tail & RX_RING_MASK];
+    g_rx_tail = tail + 1;
+    return 1;
+}
+
+
+unsigned char ioport_peek(const unsigned char** data) {
+    const unsigned char tail = g_rx_tail;
+    const unsigned char used = (unsigned char) (g_rx_head - tail);
+    const unsigned char to_end = IOPORT_RX_RING_SIZE - (tail & RX_RING_MASK);
+    
+    // The ISR never writes the bytes between tail and head, so they can be
+    // handed out without the volatile qualifier until they are consumed.
+    *data = (const unsigned char*) &g_rx_ring[tail & RX_RING_MASK];
+    return (used < to_end) ? used : to_end;
+}
+
+
+unsigned char ioport_peek_timed(const unsigned char** data,
+                                const uint16_t** times) {
+    const unsigned char count = ioport_peek(data);
+    *times = (const uint16_t*) &g_rx_time[g_rx_tail & RX_RING_MASK];
+    return count;
+}
+
+
+void ioport_consume(unsigned char count) {
+    g_rx_tail += count;
+}
+
+
+void ioport_get_stats(ioport_stats_t* stats) {
+    HAL_USART_RX_IRQ_DISABLE();
+    *stats = g_stats;
+    HAL_USART_RX_IRQ_ENABLE();
+}
+
+
+void ioport_reset_stats() {
+    HAL_USART_RX_IRQ_DISABLE();
+    clear_stats();
+    HAL_USART_RX_IRQ_ENABLE();
+}
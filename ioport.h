@@ -3,24 +3,68 @@
  * All Rights Reserved
  * 
  * Routines for initializing and reading/writing serial I/O.
+ *
+ * Received bytes are moved out of the USART by a high-priority interrupt
+ * handler, ioport_rx_isr(), into a ring buffer. The ring has a single
+ * producer (the ISR) and a single consumer, each of which owns one index,
+ * so no locking is needed on the PIC18. In the synth the consumer is the
+ * MIDI decoder that runs in the same interrupt (see eventq.h.)
  */
 #ifndef IOPORT_H_INCLUDED_
 #define IOPORT_H_INCLUDED_
 
+#include <stdint.h>
 #include "status.h"
 
+// Size of the receive ring buffer in bytes. Must be a power of two no
+// larger than 128. At 31250 baud, 64 bytes absorb about 20ms of loop stall.
+#ifndef IOPORT_RX_RING_SIZE
+#define IOPORT_RX_RING_SIZE 64
+#endif
+
 typedef enum ioport_errors {
     E_IOPORT_INVALID_BAUDRATE = -1
-};
+} ioport_error_t;
+
+/**
+ * Receive statistics, for sizing the ring and MIDI routing.
+ */
+typedef struct ioport_stats {
+    unsigned long rx_bytes;       // Bytes read from the USART (incl. errors.)
+    unsigned long rx_overruns;    // Hardware overruns (OERR) recovered from.
+    unsigned long rx_framing;     // Bytes discarded with framing errors.
+    unsigned long rx_dropped;     // Bytes discarded because the ring was full.
+    unsigned char rx_high_water;  // Most bytes ever waiting in the ring.
+} ioport_stats_t;
 
 /**
- * Initialize the I/O port.
+ * Initialize the I/O port and enable the receive interrupt. Interrupts must
+ * also be enabled globally before bytes start arriving in the ring.
  * 
  * @param baudrate The baud rate for communication.
  * @return Return zero on success, negative error code otherwise.
  */
 status_t ioport_init(unsigned long int baudrate);
 
+/**
+ * Receive interrupt handler; moves every byte waiting in the USART into the
+ * ring buffer. Must be called from the high-priority interrupt vector.
+ *
+ * Bytes received with a framing error are discarded. An overrun stops the
+ * USART from receiving; the handler restarts reception once the FIFO has
+ * been drained, so only the bytes that did not fit are lost.
+ */
+void ioport_rx_isr();
+
+/**
+ * Return the count of bytes taken from the USART, modulo 256: it changes
+ * whenever a byte comes in, even one that is then discarded. Call from the
+ * high-priority interrupt, or with it disabled.
+ *
+ * @return Bytes received, modulo 256.
+ */
+unsigned char ioport_rx_count();
+
 /**
  * Return nonzero when there is data available, zero otherwise.
  * 
@@ -28,6 +72,12 @@ status_t ioport_init(unsigned long int baudrate);
  */
 char ioport_data_ready();
 
+/**
+ * Return the number of received bytes waiting in the ring buffer.
+ *
+ * @return Number of bytes that can be read without blocking.
+ */
+unsigned char ioport_available();
 
 /**
  * Read a byte from the I/O port. Note: this function spins if necessary
@@ -38,4 +88,54 @@ char ioport_data_ready();
  */
 char ioport_read();
 
-#endif  // IOPORT_H_INCLUDED_
\ No newline at end of file
+/**
+ * Read a byte from the I/O port if one is available.
+ *
+ * @param byte Receives the byte read.
+ * @return 1 if a byte was read, 0 if the ring buffer was empty.
+ */
+char ioport_read_nonblocking(char* byte);
+
+/**
+ * Look at the received bytes in place, without copying them out of the
+ * ring. Because the ring wraps, this is the contiguous run starting at the
+ * oldest byte, which may be only part of what is available. The bytes stay
+ * in the ring (and 'data' stays valid) until ioport_consume() is called.
+ *
+ * @param data Receives a pointer to the oldest byte.
+ * @return Number of contiguous bytes at 'data'; zero if the ring is empty.
+ */
+unsigned char ioport_peek(const unsigned char** data);
+
+/**
+ * As ioport_peek(), with the arrival time of each byte (the low 16 bits of
+ * the clock; see clock.h), which stay valid as long as the bytes do.
+ *
+ * @param data Receives a pointer to the oldest byte.
+ * @param times Receives a pointer to the arrival time of that byte.
+ * @return Number of contiguous bytes (and times); zero if the ring is
+ *         empty.
+ */
+unsigned char ioport_peek_timed(const unsigned char** data,
+                                const uint16_t** times);
+
+/**
+ * Release bytes returned by ioport_peek() back to the ring.
+ *
+ * @param count Number of bytes to release; no more than ioport_peek()
+ *              returned.
+ */
+void ioport_consume(unsigned char count);
+
+/**
+ * Copy the receive statistics. The receive interrupt is briefly disabled so
+ * that the copy is consistent.
+ *
+ * @param stats Receives the statistics.
+ */
+void ioport_get_stats(ioport_stats_t* stats);
+
+// Reset the receive statistics to zero.
+void ioport_reset_stats();
+
+#endif  // IOPORT_H_INCLUDED_
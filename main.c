@@ -9,13 +9,16 @@
  * 
  */
 #include <xc.h>
+#include "clock.h"
 #include "config.h"
+#include "dac.h"
 #include "display.h"
-#include "intel8254.h"
+#include "eventq.h"
+#include "hal.h"
 #include "ioport.h"
-#include "midi.h"
-#include "midi_notes.h"
+#include "sched.h"
 #include "status.h"
+#include "synth.h"
 
 // Here, we are configuring various settings on the PIC18. The most important
 // setting to note here is 'OSC', which we set to 'HS'. This configures the
@@ -33,281 +36,41 @@
 #pragma config BOREN = 0
 
 
-// Number of keys currently depressed (AKA notes on.)
-static int g_notes_on = 0;
-
-// The current value of the pitch bend wheel (center is 8192.)
-static long int g_pitch_bend = 8192;
-
-// The freqency of the note on
-static long int g_note_on_freq = 20000;
-
-// The current frequency that is actually playing.
-static long int g_actual_freq = 20000;
-
-// The desired target frequency (calculated as a result of pitch bend, etc,.)
-static long int g_target_freq = 20000;
-
-
-void on_note_off() {
-    --g_notes_on;
-    if (g_notes_on <= 0) {
-        intel_write_timer(0, 1, 0);
-        intel_write_timer(1, 1, 0);
-        g_notes_on = 0;
-        g_note_on_freq = 20000;
-        g_actual_freq = 20000;
-        g_target_freq = 20000;
-    }
-}
-
 // Report error state using a system peripheral
 void error(status_t c) {
-    PORTDbits.RD0 = 1;
+    HAL_LED_ERROR(1);
     // TODO(tdial): Implement
     for (;;);
 }
 
-void on_midi_active_sensing(char, char, char) {
-    // TODO(tdial): Update event watchdog timer; if we don't get any
-    // event or active sensing message in some period of time, we will
-    // want to silence all oscillators.
-}
-
-
-void on_midi_note_off(char chan, char key, char val) {
-    // Turn off LED for note off.
-    PORTDbits.RD1 = 0;
-    on_note_off();
-}
-
-// This is really OSC / 65535
-#define MIN_FREQ 32
-
-long calc_oscillator_frequency(long base_freq, long bender) {
-    long new_freq = 0;
-    if (bender < (8192 - 20)) {
-        new_freq = (base_freq * (bender + 8192)) / 16384;
-        if (new_freq < MIN_FREQ) {
-            new_freq = MIN_FREQ;
-        }
-    } else if (bender > (8192 + 20)) {
-        new_freq = (base_freq * bender) / 8192;
-        if (new_freq > 20000) {
-            new_freq = 20000;
-        }
-    } else {
-        return base_freq;
-    }
-    return new_freq;
-}
-
-
-void set_oscillator_frequency(int osc, long freq) {
-    const unsigned long clock = 2000000;
-    const unsigned long divisor = clock / freq;
-    const char lsb = (unsigned char) (divisor & 0xff);
-    const char msb = (unsigned char) ((divisor >> 8) & 0xff);
-    intel_write_timer(osc, lsb, msb);
-}
-
-
-void on_midi_note_on(char chan, char key, char vel) {
-    // Instruments sometimes send "note off" messages as note on messages
-    // with a velocity of zero. Check here for that condition and delegate
-    // to the handler for note off.
-    if (vel == 0) {
-        on_midi_note_off(chan, key, vel);
-        return;
-    }
-    
-    // Light LED for midi note on
-    PORTDbits.RD1 = 1;
-    
-    ++g_notes_on;
-    
-    char lsb = 0;
-    char msb = 0;
-    
-    // Given the MIDI note, which frequency should we be playing?
-    // Calculate the new global frequency and store it there.
-    g_note_on_freq = midi_note_frequency_for_note(key);
-    
-    // What is the ACTUAL frequency we should play based on pitch bend.
-    const long actual = calc_oscillator_frequency(g_note_on_freq, g_pitch_bend);
-    
-    // Now, set the oscillator frequency, which uses the global frequency.
-    // as well as the current pitch bend value.
-    set_oscillator_frequency(0, actual);
-    set_oscillator_frequency(1, actual + 10);
-    set_oscillator_frequency(2, actual);
-    
-
-    // At the time of note on, frequency values are all the same.
-    g_actual_freq = actual;
-    g_target_freq = actual;
-}
-
-// Configure I/O pins used in the system, set them to their initial state.
-status_t iopins_init() {
-    TRISB = 0;
-    PORTB = 0;
-    
-    TRISC = 0;
-    PORTC = 0;
-    
-    TRISD = 0;
-    PORTD = 0;
-    
-    PORTCbits.RC3 = 0;
-    
-    //for (int i = 0; i < 20; ++i) {
-    //    PORTDbits.RD1 = 1;
-    //    __delay_ms(100);
-    //}
-    //PORTDbits.RD1 = 0;
-    
-    return 0;
-}
-
-
-void on_pitch_bend(char chan, char lsb, char msb) {
-    lsb &= 0x7f;
-    msb &= 0x7f;
-    long pitch_bend = msb;
-    pitch_bend <<= 7;
-    pitch_bend |= lsb;
-    g_pitch_bend = pitch_bend;
-    
-    // Calculate the new "target" frequency.
-    g_target_freq = calc_oscillator_frequency(g_note_on_freq, g_pitch_bend);
-
-}
-
-// Perform initial system initialization.
-status_t system_init() {
-    status_t status = 0;
-    
-    // Configure and initialize I/O pins used in the system.
-    status = iopins_init();
-    if (status) {
-        return status;
-    }
-    
-    // Initialize the USART for receive / transmit.
-    status = ioport_init(MIDI_BAUD_RATE);
-    if (status) {
-        return status;
-    }
-    
-    // Initialize the Intel 8254 Timer 
-    status = intel_8254_init();
-    if (status) {
-        return status;
-    }
-    
-    // Initialize MIDI library.
-    status = midi_init();
-    if (status) {
-        return status;
+// High-priority interrupt vector.
+void interrupt high_priority isr_high(void) {
+    // USART receive: move the waiting bytes into the ioport ring buffer,
+    // then decode them into the event queue.
+    if (HAL_USART_RX_READY()) {
+        ioport_rx_isr();
+        eventq_rx_isr();
     }
     
-    status = midi_register_event_handler(EVT_SYS_REALTIME_ACTIVE_SENSE,
-                                         on_midi_active_sensing);
-
-    status = midi_register_event_handler(EVT_CHAN_NOTE_OFF,
-                                         on_midi_note_off);
-
-    status = midi_register_event_handler(EVT_CHAN_NOTE_ON,
-                                         on_midi_note_on);
-    
-    status = midi_register_event_handler(EVT_CHAN_PITCH_BEND,
-                                         on_pitch_bend);
-    
-    // TODO(tdial): Eliminate
-    on_midi_note_off(0, 0, 0);
-    
-    if (status) {
-        return status;
+    // Control tick (Timer2.)
+    if (HAL_TICK_PENDING()) {
+        HAL_TICK_CLEAR();
+        synth_tick_isr();
     }
     
-    return 0;
-}
-
-
-// Main event handler and dispatcher; runs continuously.
-void loop() {
-    char byte = 0;
-    if (ioport_data_ready()) {
-        byte = ioport_read();
-        midi_receive_byte(byte);
+    // SPI (the DACs): a byte has been shifted out.
+    if (HAL_SPI_DONE()) {
+        HAL_SPI_CLEAR();
+        dac_spi_isr();
     }
     
-    // If the note is on and the actual has not reached the target frequency,
-    // Then bump actual in that direction by moving it halfway there.
-    if (g_notes_on && (g_actual_freq != g_target_freq)) {
-        long int delta = 0;
-        if (g_actual_freq < g_target_freq) {
-            delta = ((g_target_freq - g_actual_freq) / 10) + 1;
-            g_actual_freq += delta;
-        } else {
-            delta = ((g_actual_freq - g_target_freq) / 10) + 1;
-            g_actual_freq -= delta;
-        }
-        set_oscillator_frequency(0, g_actual_freq);
-        set_oscillator_frequency(1, g_actual_freq + 10);
-        set_oscillator_frequency(2, g_actual_freq);
+    // Clock (Timer1) overflow.
+    if (HAL_CLOCK_OVERFLOW()) {
+        HAL_CLOCK_CLEAR();
+        clock_isr();
     }
 }
 
-void init_spi_dac() {
-
-    ADCON1 = 0;
-    
-    // Configure Port A as outputs.
-    TRISA = 0;
-    
-    // Configure Pin C5 as an output; this is the SDO pin on the PIC.
-    TRISCbits.TRISC5 = 0;
-    
-    // Configure C3 as output (this is SCK might not be necessary)
-    TRISCbits.TRISC3 = 0;
-    
-    // Configure Pin C4 as an input; this is the SDI pin on the PIC.
-    TRISCbits.TRISC4 = 1;
-    
-    // We're using A1 as our chip select. Initialize to HIGH (deselected.)
-    LATAbits.LATA1 = 1;
-    
-    OpenSPI(SPI_FOSC_4, MODE_00, SMPEND); 
-    //OpenSPI(SPI_FOSC_64, MODE_11, SMPEND); */  
-}
-
-void write_dac_a(unsigned short data) {
-    unsigned short msb = 0;
-    unsigned short lsb = 0;
-    unsigned short dummy = 0;
-    
-    // Set up lsb and msb for writing value. value is in twelve bits.
-    lsb = (data & 0x00ff);
-    msb = ((data >> 8) & 0x000f);
-    
-    // Top four bits of msb contain gain selection and SHDN for
-    // active. Gain selection here is 1x.
-    msb |= (0b00110000);
-    
-    // Select chip
-    LATAbits.LATA1 = 0;
-    
-    Nop();
-    Nop();
-    
-    WriteSPI(msb);
-    WriteSPI(lsb);
-    
-    LATAbits.LATA1 = 1;
-}
-
 // Entry Point
 void main(void) {
     
@@ -316,26 +79,15 @@ void main(void) {
         error(status);
     } 
         
-    //display_open();
-    
-    init_spi_dac();
-    
-    //display_enable();
-    
-    //display_clear();
-    
-    //display_move(0, 0);
-    //display_write_string("    dial one     ");
+    // The LCD initializes itself over the first ticks, then shows the
+    // framebuffer (see display_service().)
+    display_open();
+    display_move(0, 0);
+    display_write_string("    dial one");
   
-    unsigned short x = 0;
-    
-    
+    // The scheduler runs the main loop's tasks; the DAC is driven by the
+    // modulation engine, from the control tick (see synth_tick_isr().)
     for (;;) {
-        loop();
-        //write_dac_a(x++);
-        write_dac_a(4000);
-        //if (x == 4000) {
-        //    x = 0;
-        //}
+        sched_run();
     }    
 }
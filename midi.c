@@ -5,7 +5,6 @@
  * A MIDI processing library designed for use in embedded environments.
  */
 #include "midi.h"
-#include <xc.h>
 
 
 /*
@@ -50,95 +49,90 @@
 
 
 /**
- * Enumeration that represents the states that the MIDI protocol
- * state machine can be in.
+ * System common status message types.
  */
-enum PROTOCOL_STATE {
-    // The machine is waiting for a status byte.
-    STATE_WAITING_FOR_STATUS = 0,
-    STATE_ERROR = 1,
-            
-    // Note Off: waiting for key and velocity data bytes, respectively.
-    STATE_WAITING_CHAN_NOTE_OFF_KEY,
-    STATE_WAITING_CHAN_NOTE_OFF_VELOCITY,
-    
-    // Note On: waiting for key and velocity data bytes, respectively.
-    STATE_WAITING_CHAN_NOTE_ON_KEY,      
-    STATE_WAITING_CHAN_NOTE_ON_VELOCITY,
-    
-    // Poly After-touch: waiting for key and pressure value, respectively.
-    STATE_WAITING_CHAN_POLY_AFTERTOUCH_KEY,
-    STATE_WAITING_CHAN_POLY_AFTERTOUCH_PRESSURE,
-    
-    // Channel control change: waiting for control and value data bytes.
-    // Note: depending on these values, messages of this type may be
-    // considered to be "channel mode" messages.
-    STATE_WAITING_CHAN_CONTROL_CHANGE_CONTROL,       
-    STATE_WAITING_CHAN_CONTROL_CHANGE_VALUE,       
-    
-    // Program change: waiting for the program data byte.
-    STATE_WAITING_CHAN_PROGRAM_CHANGE_PROGRAM,  
-            
-    // Channel After-touch - waiting for the pressure data byte.
-    STATE_WAITING_CHAN_AFTERTOUCH_PRESSURE,          
-            
-    // Pitch Bend: waiting for two bytes representing the bend amount.
-    // The least-significant 7 bits are sent first. The most significant
-    // bits are set second.
-    STATE_WAITING_CHAN_PITCH_BEND_LSBITS,
-    STATE_WAITING_CHAN_PITCH_BEND_MSBITS 
-};
+#define SYS_COMMON_SYSEX_START     0xf0  // Start of system exclusive message.
+#define SYS_COMMON_MTC_QUARTER     0xf1  // MIDI time code quarter frame.
+#define SYS_COMMON_SONG_POSITION   0xf2  // Song position pointer.
+#define SYS_COMMON_SONG_SELECT     0xf3  // Song select.
+#define SYS_COMMON_RESERVED_F4     0xf4  // Undefined (Reserved.)
+#define SYS_COMMON_RESERVED_F5     0xf5  // Undefined (Reserved.)
+#define SYS_COMMON_TUNE_REQUEST    0xf6  // Tune request.
+#define SYS_COMMON_SYSEX_END       0xf7  // End of system exclusive message.
+
 
 /**
- * Globals that hold current MIDI state. For now, these are globals. If
- * there is a desire to allow the library to manage more than one MIDI
- * interface, they could be placed into a structure; other routines that
- * access the globals would have to be updated accordingly.
+ * System exclusive state (midi_decoder_t::sysex.) While a message is open,
+ * data bytes are payload; PENDING means that no chunk has been delivered
+ * yet, so the next one carries MIDI_SYSEX_START.
  */
+#define SYSEX_IDLE                 0
+#define SYSEX_PENDING              1
+#define SYSEX_STREAMING            2
 
-// State of the "MIDI protocol state machine"
-static char g_state = STATE_WAITING_FOR_STATUS;
-
-// Last bytes received, saved for debugging.
-static char g_debug_last_status_byte = 0;
-static char g_debug_last_data_byte = 0;
 
-// The following three variables are updated during message parsing.
-static char g_current_channel = 0;
-static char g_data_byte_one = 0;
-static char g_data_byte_two = 0;
-
-// Counter that records number of complete MIDI messages received.
-static unsigned long g_message_counter = 0;
+/**
+ * Message descriptions. Each entry gives the number of data bytes that
+ * follow the status byte and the event that the complete message is
+ * dispatched as (EVT_MAX if it is not dispatched.)
+ */
+typedef struct message_info {
+    unsigned char length;
+    unsigned char event;
+} message_info_t;
+
+// Channel messages, indexed by the message type (the upper nibble of the
+// status byte) less 8.
+static const message_info_t CHANNEL_MESSAGES[7] = {
+    { 2, EVT_CHAN_NOTE_OFF },         // CHAN_NOTE_OFF: key, velocity
+    { 2, EVT_CHAN_NOTE_ON },          // CHAN_NOTE_ON: key, velocity
+    { 2, EVT_CHAN_POLY_AFTERTOUCH },  // CHAN_POLY_AFTER_TOUCH: key, pressure
+    { 2, EVT_CHAN_CONTROL_CHANGE },   // CHAN_CONTROL_CHANGE: control, value
+    { 1, EVT_CHAN_PROGRAM_CHANGE },   // CHAN_PROGRAM_CHANGE: program
+    { 1, EVT_CHAN_AFTERTOUCH },       // CHAN_AFTER_TOUCH: pressure
+    { 2, EVT_CHAN_PITCH_BEND }        // CHAN_PITCH_BEND: LS 7 bits, MS 7 bits
+};
 
+// System common messages, indexed by the low 3 bits of the status byte. The
+// payload of a system exclusive message is streamed separately, and the end
+// of exclusive byte only closes it.
+static const message_info_t SYSTEM_COMMON_MESSAGES[8] = {
+    { 0, EVT_MAX },                           // SYS_COMMON_SYSEX_START
+    { 1, EVT_SYS_COMMON_MTC_QUARTER_FRAME },  // SYS_COMMON_MTC_QUARTER: data
+    { 2, EVT_SYS_COMMON_SONG_POSITION },      // SYS_COMMON_SONG_POSITION: LS,MS
+    { 1, EVT_SYS_COMMON_SONG_SELECT },        // SYS_COMMON_SONG_SELECT: song
+    { 0, EVT_MAX },                           // SYS_COMMON_RESERVED_F4
+    { 0, EVT_MAX },                           // SYS_COMMON_RESERVED_F5
+    { 0, EVT_SYS_COMMON_TUNE_REQUEST },       // SYS_COMMON_TUNE_REQUEST
+    { 0, EVT_MAX }                            // SYS_COMMON_SYSEX_END
+};
 
-// Callback table.
-static midi_event_callback_t g_callbacks[EVT_MAX] = {0};
+/**
+ * The parser state lives in a midi_parser_t (see midi.h), so that any number
+ * of MIDI interfaces can be handled independently. The midi_xxx() functions
+ * that take no parser operate on the default instance below.
+ */
+static midi_parser_t g_default_parser;
 
 
 // The null event callback is used by default for all events.
 static void null_event_cb(char channel, char a, char b) {
-    // Just implement the event counter.
-    ++g_message_counter;
+}
+
+
+// The null system exclusive callback is used by default.
+static void null_sysex_cb(const uint8_t* data, size_t len,
+                          unsigned char flags) {
 }
 
 
 // Wrapper that invokes callback functions.
-static inline void invoke_callback(int evt) {
-    // Reject invalid events.
-    if ((evt < 0) || (evt >= EVT_MAX)) {
-        return;
-    }
-    
-    // Increment the global event counter.
-    ++g_message_counter;
+static inline void invoke_callback(midi_parser_t* p, const midi_event_t* evt) {
+    // Increment the event counter.
+    ++p->message_counter;
     
     // Invoke the callback.
-    (g_callbacks[evt])(g_current_channel, g_data_byte_one, g_data_byte_two);
-    
-    // Clear data state
-    g_data_byte_one = 0;
-    g_data_byte_two = 0;
+    (p->callbacks[evt->type])(evt->channel, evt->data1, evt->data2);
 }
 
 
@@ -158,220 +152,164 @@ static inline void invoke_callback(int evt) {
  * and then processing of the MIDI byte stream should continue as though the
  * real-time byte was never received.
  */
-static status_t rx_status_sys_realtime_byte(char byte) {
-    switch (byte) {
-        case SYS_REALTIME_TIMING_CLOCK:
-            invoke_callback(EVT_SYS_REALTIME_TIMING_CLOCK);
-            break;
-            
-        case SYS_REALTIME_RESERVED_F9:
-            invoke_callback(EVT_SYS_REALTIME_RESERVED_F9);
-            break;
-            
-        case SYS_REALTIME_SEQ_START:
-            invoke_callback(EVT_SYS_REALTIME_SEQ_START);
-            break;
-            
-        case SYS_REALTIME_SEQ_CONTINUE:
-            invoke_callback(EVT_SYS_REALTIME_SEQ_CONTINUE);
-            break;
-            
-        case SYS_REALTIME_SEQ_STOP:
-            invoke_callback(EVT_SYS_REALTIME_SEQ_STOP);
-            break;
-            
-        case SYS_REALTIME_RESERVED_FD:
-            invoke_callback(EVT_SYS_REALTIME_RESERVED_FD);
-            break;
-            
-        case SYS_REALTIME_ACTIVE_SENSE:
-            invoke_callback(EVT_SYS_REALTIME_ACTIVE_SENSE);
-            break;
-            
-        case SYS_REALTIME_RESET:
-            invoke_callback(EVT_SYS_REALTIME_RESET);
-            break;
-    }
+static unsigned char rx_status_sys_realtime_byte(unsigned char byte,
+                                                 midi_event_t* evt) {
+    // The real-time events are numbered in the same order as the status
+    // bytes, 0xf8 to 0xff.
+    evt->type = byte & 0x07;
+    evt->channel = 0;
+    evt->data1 = 0;
+    evt->data2 = 0;
     return 1;
 }
 
 
-// Process a "system common" status byte (0 or more data bytes follow.)
-static status_t rx_status_sys_common_byte(char byte) {
-    return 0;
+// Hand a span of system exclusive payload to the application.
+static inline void sysex_data(midi_decoder_t* d, const uint8_t* data,
+                              size_t len) {
+    unsigned char flags = (d->sysex == SYSEX_PENDING) ? MIDI_SYSEX_START : 0;
+    d->sysex = SYSEX_STREAMING;
+    (d->sysex_callback)(data, len, flags);
 }
 
 
-// Process a "channel" status byte. (1 or 2 data bytes follow.)
-static status_t rx_status_channel_byte(char byte) {
-    // Mask of the channel bits, leaving only the message type.
-    const char type = (byte & CHAN_TYPE_MASK);
-    
-    // Update the state machine with the MIDI channel of the message that
-    // we are now processing. This is held in a global.
-    g_current_channel = (byte & CHAN_MASK);
-    
-    switch (type) {
-        case CHAN_NOTE_OFF:
-            g_state = STATE_WAITING_CHAN_NOTE_OFF_KEY;
-            break;
-            
-        case CHAN_NOTE_ON:
-            g_state = STATE_WAITING_CHAN_NOTE_ON_KEY;
-            break;
-            
-        case CHAN_POLY_AFTER_TOUCH:
-            g_state = STATE_WAITING_CHAN_POLY_AFTERTOUCH_KEY;
-            break;
-            
-        case CHAN_CONTROL_CHANGE:
-            g_state = STATE_WAITING_CHAN_CONTROL_CHANGE_CONTROL;
-            break;
-            
-        case CHAN_PROGRAM_CHANGE:
-            g_state = STATE_WAITING_CHAN_PROGRAM_CHANGE_PROGRAM;
-            break;
-            
-        case CHAN_AFTER_TOUCH:
-            g_state = STATE_WAITING_CHAN_AFTERTOUCH_PRESSURE;
-            break;
-            
-        case CHAN_PITCH_BEND:
-            g_state = STATE_WAITING_CHAN_PITCH_BEND_LSBITS;
-            break;
-            
-        default:
-            g_state = STATE_ERROR;
-            return E_MIDI_BAD_CHANNEL_STATE;
+// Close the open system exclusive message with an empty, final chunk.
+static void sysex_end(midi_decoder_t* d, unsigned char flags) {
+    if (d->sysex == SYSEX_PENDING) {
+        flags |= MIDI_SYSEX_START;
     }
-    return 0;
+    d->sysex = SYSEX_IDLE;
+    (d->sysex_callback)(NULL, 0, flags | MIDI_SYSEX_END);
 }
 
 
-// Process a trailing data byte.
-static status_t rx_data_byte(char byte) {
-    switch (g_state) {
-        // Process first byte of a "note off" message.
-        case STATE_WAITING_CHAN_NOTE_OFF_KEY:
-            g_data_byte_one = byte;
-            g_state = STATE_WAITING_CHAN_NOTE_OFF_VELOCITY;
-            break;
-            
-        // Process second byte of a "note off" message, and invoke callback.
-        // We reset the state in case there is a "running state" note off.
-        case STATE_WAITING_CHAN_NOTE_OFF_VELOCITY:
-            g_data_byte_two = byte;
-            invoke_callback(EVT_CHAN_NOTE_OFF);
-            g_state = STATE_WAITING_CHAN_NOTE_OFF_KEY;
-            return 1;
-            
-        // Process first byte of a "note on" message.
-        case STATE_WAITING_CHAN_NOTE_ON_KEY:
-            g_data_byte_one = byte;
-            g_state = STATE_WAITING_CHAN_NOTE_ON_VELOCITY;
-            break;
-            
-        // Process second byte of a "note on" message, and invoke callback.
-        case STATE_WAITING_CHAN_NOTE_ON_VELOCITY:
-            g_data_byte_two = byte;
-            invoke_callback(EVT_CHAN_NOTE_ON);
-            g_state = STATE_WAITING_CHAN_NOTE_ON_KEY;
-            return 1;
-            
-        // Process first byte of a poly after-touch message.    
-        case STATE_WAITING_CHAN_POLY_AFTERTOUCH_KEY:
-            g_data_byte_one = byte;
-            g_state = STATE_WAITING_CHAN_POLY_AFTERTOUCH_PRESSURE;
-            break;
-        
-        // Process second byte of a poly after-touch message, invoke callback.
-        case STATE_WAITING_CHAN_POLY_AFTERTOUCH_PRESSURE:
-            g_data_byte_two = byte;
-            invoke_callback(EVT_CHAN_POLY_AFTERTOUCH);
-            g_state = STATE_WAITING_CHAN_POLY_AFTERTOUCH_KEY;
-            return 1;
-        
-        // Process first byte of a channel control change message.
-        case STATE_WAITING_CHAN_CONTROL_CHANGE_CONTROL:
-            g_data_byte_one = byte;
-            g_state = STATE_WAITING_CHAN_CONTROL_CHANGE_VALUE;
-            break;
-        
-        // Process second byte of a channel control change, invoke callback.    
-        case STATE_WAITING_CHAN_CONTROL_CHANGE_VALUE:    
-            g_data_byte_two = byte;
-            invoke_callback(EVT_CHAN_CONTROL_CHANGE);
-            g_state = STATE_WAITING_CHAN_CONTROL_CHANGE_CONTROL;
-            return 1;
-            
-        // Process program change, invoke callback.
-        case STATE_WAITING_CHAN_PROGRAM_CHANGE_PROGRAM:
-            g_data_byte_one = byte;
-            g_data_byte_two = 0;
-            invoke_callback(EVT_CHAN_PROGRAM_CHANGE);
-            // Leave state intact in case there is another via running status.
-            return 1;
-        
-        // Process channel after-touch message, invoke callback.     
-        case STATE_WAITING_CHAN_AFTERTOUCH_PRESSURE:
-            g_data_byte_one = byte;
-            g_data_byte_two = 0;
-            invoke_callback(EVT_CHAN_AFTERTOUCH);
-            // Leave state intact in case there is another via running status.
-            return 1;
-        
-        // Process first byte of pitch bend.    
-        case STATE_WAITING_CHAN_PITCH_BEND_LSBITS:
-            g_data_byte_one = byte;
-            g_state = STATE_WAITING_CHAN_PITCH_BEND_MSBITS;
-            break;
-        
-        // Process second byte of pitch bend.    
-        case STATE_WAITING_CHAN_PITCH_BEND_MSBITS:
-            g_data_byte_two = byte;
-            invoke_callback(EVT_CHAN_PITCH_BEND);
-            g_state = STATE_WAITING_CHAN_PITCH_BEND_LSBITS;
-            return 1;
-        
-        // Handle bad state.    
-        default:
-            g_data_byte_one = 0;
-            g_data_byte_two = 0;
-            // TODO(tdial): Do we have to touch the state?
-            break;
+/**
+ * Process a "system common" status byte (0 to 2 data bytes follow, or the
+ * payload of a system exclusive message.)
+ * 
+ * System common messages cancel running status: once the message is
+ * complete, data bytes are ignored until the next channel status byte.
+ */
+static unsigned char rx_status_sys_common_byte(midi_decoder_t* d,
+                                               unsigned char byte,
+                                               midi_event_t* evt) {
+    const message_info_t* msg = &SYSTEM_COMMON_MESSAGES[byte & 0x07];
+    
+    // Any status byte other than real-time ends a system exclusive message;
+    // only end of exclusive ends it normally.
+    if (d->sysex) {
+        sysex_end(d, (byte == SYS_COMMON_SYSEX_END) ? 0 : MIDI_SYSEX_ABORTED);
+    }
+    
+    d->event = msg->event;
+    d->length = msg->length;
+    d->remaining = msg->length;
+    d->running = 0;
+    
+    if (byte == SYS_COMMON_SYSEX_START) {
+        d->sysex = SYSEX_PENDING;
+        return 0;
     }
     
-    // No messages processed; return 0.
+    // Tune request has no data bytes, so it is complete already.
+    if ((msg->length == 0) && (msg->event != EVT_MAX)) {
+        evt->type = msg->event;
+        evt->channel = 0;
+        evt->data1 = 0;
+        evt->data2 = 0;
+        return 1;
+    }
     return 0;
 }
 
 
-/****************************************************************************
- * Public APIs                                                              *
- ****************************************************************************/
-
-
-status_t midi_init() {
-    // Initialize the callback table; all events to the null callback.
-    for (int i = 0; i < EVT_MAX; ++i) {
-        g_callbacks[i] = null_event_cb;
+// Process a "channel" status byte. (1 or 2 data bytes follow.)
+static unsigned char rx_status_channel_byte(midi_decoder_t* d,
+                                            unsigned char byte) {
+    // The message type selects the table entry; 0x80 - 0xe0 map to 0 - 6.
+    const message_info_t* msg = &CHANNEL_MESSAGES[(byte >> 4) & 0x07];
+    
+    if (d->sysex) {
+        sysex_end(d, MIDI_SYSEX_ABORTED);
     }
+    
+    // Update the state machine with the MIDI channel of the message that
+    // we are now processing.
+    d->channel = (byte & CHAN_MASK);
+    
+    d->event = msg->event;
+    d->length = msg->length;
+    d->remaining = msg->length;
+    d->running = 1;
     return 0;
 }
 
 
-status_t midi_register_event_handler(event_type evt, midi_event_callback_t cb) {
-    if (cb) {
-        g_callbacks[evt] = cb;
+// Process a trailing data byte.
+static unsigned char rx_data_byte(midi_decoder_t* d, unsigned char byte,
+                                  midi_event_t* evt) {
+    // Outside of a message, a data byte is either system exclusive payload
+    // or is ignored (there is no status to apply it to.)
+    if (!d->length) {
+        if (d->sysex) {
+            sysex_data(d, &byte, 1);
+        }
+        return 0;
+    }
+    
+    if (d->remaining == d->length) {
+        d->data1 = byte;
+        d->data2 = 0;
     } else {
-        g_callbacks[evt] = null_event_cb;
+        d->data2 = byte;
     }
     
-    return 0;    
+    if (--d->remaining) {
+        // No messages processed; return 0.
+        return 0;
+    }
+    
+    // The message is complete. Re-arm a channel message for another with
+    // the same status, in case the sender uses running status.
+    evt->type = d->event;
+    evt->channel = d->running ? d->channel : 0;
+    evt->data1 = d->data1;
+    evt->data2 = d->data2;
+    if (d->running) {
+        d->remaining = d->length;
+    } else {
+        d->length = 0;
+    }
+    return 1;
 }
 
 
-status_t midi_receive_byte(char byte) {
+/**
+ * Hand over the system exclusive payload at the start of 'data' in place,
+ * as one chunk of up to MIDI_SYSEX_CHUNK_SIZE data bytes; the chunk ends
+ * early at a status byte or at the end of the span. Returns its length.
+ */
+static size_t sysex_run(midi_decoder_t* d, const uint8_t* data, size_t len) {
+    size_t run = 1;
+    if (len > MIDI_SYSEX_CHUNK_SIZE) {
+        len = MIDI_SYSEX_CHUNK_SIZE;
+    }
+    while ((run < len) && !(data[run] & CHAN_STATUS_MASK)) {
+        ++run;
+    }
+    d->debug_last_data_byte = data[run - 1];
+    sysex_data(d, data, run);
+    return run;
+}
+
+
+/**
+ * Run one byte through the protocol state machine. Returns 1 and fills in
+ * the event when the byte completes a message, and returns 0 otherwise.
+ */
+static inline unsigned char decode_byte(midi_decoder_t* d,
+                                        unsigned char byte,
+                                        midi_event_t* evt) {
     /*
      * The statements below, which are performed in deliberate order, determine
      * which type of byte has arrived on the input. First, we test the lead
@@ -385,19 +323,265 @@ status_t midi_receive_byte(char byte) {
     
     if ((byte & SYS_REALTIME_MASK) == SYS_REALTIME_MASK) {
         // The byte is a system real-time status byte.
-        g_debug_last_status_byte = byte;
-        return rx_status_sys_realtime_byte(byte);
+        d->debug_last_status_byte = byte;
+        return rx_status_sys_realtime_byte(byte, evt);
     } else if ((byte & SYS_COMMON_MASK) == SYS_COMMON_MASK) {
         // The byte is a system common status byte.
-        g_debug_last_status_byte = byte;
-        return rx_status_sys_common_byte(byte);
+        d->debug_last_status_byte = byte;
+        return rx_status_sys_common_byte(d, byte, evt);
     } else if (byte & CHAN_STATUS_MASK) {
         // The byte is a channel voice or channel mode status byte.
-        g_debug_last_status_byte = byte;
-        return rx_status_channel_byte(byte);
+        d->debug_last_status_byte = byte;
+        return rx_status_channel_byte(d, byte);
     } else {
         // The byte is a regular data byte.
-        g_debug_last_data_byte = byte;
-        return rx_data_byte(byte);
+        d->debug_last_data_byte = byte;
+        return rx_data_byte(d, byte, evt);
+    }
+}
+
+
+/****************************************************************************
+ * Public APIs                                                              *
+ ****************************************************************************/
+
+
+void midi_decoder_reset(midi_decoder_t* d) {
+    d->event = EVT_MAX;
+    d->length = 0;
+    d->remaining = 0;
+    d->running = 0;
+    d->sysex = SYSEX_IDLE;
+    d->channel = 0;
+    d->data1 = 0;
+    d->data2 = 0;
+}
+
+
+void midi_decoder_init(midi_decoder_t* d) {
+    midi_decoder_reset(d);
+    d->debug_last_status_byte = 0;
+    d->debug_last_data_byte = 0;
+    d->sysex_callback = null_sysex_cb;
+}
+
+
+void midi_decoder_register_sysex_handler(midi_decoder_t* d,
+                                         midi_sysex_callback_t cb) {
+    d->sysex_callback = cb ? cb : null_sysex_cb;
+}
+
+
+unsigned char midi_decoder_decode_byte(midi_decoder_t* d, unsigned char byte,
+                                       midi_event_t* evt) {
+    return decode_byte(d, byte, evt);
+}
+
+
+size_t midi_decoder_sysex_span(midi_decoder_t* d, const uint8_t* data,
+                               size_t len) {
+    if (!len || !d->sysex || (data[0] & CHAN_STATUS_MASK)) {
+        return 0;
+    }
+    return sysex_run(d, data, len);
+}
+
+
+void midi_parser_reset(midi_parser_t* p) {
+    midi_decoder_reset(&p->decoder);
+    p->time = 0;
+}
+
+
+status_t midi_parser_init(midi_parser_t* p) {
+    midi_decoder_init(&p->decoder);
+    p->time = 0;
+    p->message_counter = 0;
+    
+    // Initialize the callback table; all events to the null callback.
+    for (int i = 0; i < EVT_MAX; ++i) {
+        p->callbacks[i] = null_event_cb;
     }
+    return 0;
+}
+
+
+status_t midi_parser_register_event_handler(midi_parser_t* p,
+                                            event_type evt,
+                                            midi_event_callback_t cb) {
+    if ((evt < 0) || (evt >= EVT_MAX)) {
+        return E_MIDI_BAD_EVENT_HANDLER;
+    }
+    
+    if (cb) {
+        p->callbacks[evt] = cb;
+    } else {
+        p->callbacks[evt] = null_event_cb;
+    }
+    
+    return 0;    
+}
+
+
+void midi_parser_register_sysex_handler(midi_parser_t* p,
+                                        midi_sysex_callback_t cb) {
+    midi_decoder_register_sysex_handler(&p->decoder, cb);
+}
+
+
+status_t midi_parser_receive_byte(midi_parser_t* p, char byte) {
+    midi_event_t evt;
+    if (!decode_byte(&p->decoder, byte, &evt)) {
+        return 0;
+    }
+    p->time = 0;
+    invoke_callback(p, &evt);
+    return 1;
+}
+
+
+// Parse a span, with the arrival time of each byte or none. The time of
+// the byte that completes a message is the message's; only those are
+// looked at.
+static status_t receive_span(midi_parser_t* p, const uint8_t* data,
+                             const uint16_t* times, size_t len) {
+    midi_event_t evt;
+    status_t count = 0;
+    
+    if (!times) {
+        p->time = 0;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        const size_t run = midi_decoder_sysex_span(&p->decoder, data + i,
+                                                   len - i);
+        if (run) {
+            i += run - 1;
+            continue;
+        }
+        
+        if (decode_byte(&p->decoder, data[i], &evt)) {
+            if (times) {
+                p->time = times[i];
+            }
+            invoke_callback(p, &evt);
+            ++count;
+        }
+    }
+    return count;
+}
+
+
+status_t midi_parser_receive_span(midi_parser_t* p,
+                                  const uint8_t* data, size_t len) {
+    return receive_span(p, data, 0, len);
+}
+
+
+status_t midi_parser_receive_span_timed(midi_parser_t* p,
+                                        const uint8_t* data,
+                                        const uint16_t* times, size_t len) {
+    return receive_span(p, data, times, len);
+}
+
+
+uint16_t midi_parser_event_time(const midi_parser_t* p) {
+    return p->time;
+}
+
+
+size_t midi_parser_receive_buffer(midi_parser_t* p,
+                                  const uint8_t* data, size_t len,
+                                  midi_event_t* out, size_t cap) {
+    midi_event_t overflow;
+    size_t count = 0;
+    
+    // Decode straight into the caller's array while there is room. Once it
+    // is full, keep decoding (so the parser state stays in step with the
+    // stream) but only count the events.
+    for (size_t i = 0; i < len; ++i) {
+        const size_t run = midi_decoder_sysex_span(&p->decoder, data + i,
+                                                   len - i);
+        if (run) {
+            i += run - 1;
+            continue;
+        }
+        
+        if (count < cap) {
+            count += decode_byte(&p->decoder, data[i], &out[count]);
+        } else {
+            count += decode_byte(&p->decoder, data[i], &overflow);
+        }
+    }
+    
+    p->message_counter += count;
+    return count;
+}
+
+
+void midi_parser_dispatch(midi_parser_t* p, const midi_event_t* evt,
+                          uint16_t time) {
+    // The event comes from outside the parser; one that is not valid has no
+    // entry in the callback table.
+    if (evt->type >= EVT_MAX) {
+        return;
+    }
+    p->time = time;
+    invoke_callback(p, evt);
+}
+
+
+/*
+ * The default instance.
+ */
+
+status_t midi_init() {
+    return midi_parser_init(&g_default_parser);
+}
+
+
+void midi_reset() {
+    midi_parser_reset(&g_default_parser);
+}
+
+
+status_t midi_register_event_handler(event_type evt, midi_event_callback_t cb) {
+    return midi_parser_register_event_handler(&g_default_parser, evt, cb);
+}
+
+
+void midi_register_sysex_handler(midi_sysex_callback_t cb) {
+    midi_parser_register_sysex_handler(&g_default_parser, cb);
+}
+
+
+status_t midi_receive_byte(char byte) {
+    return midi_parser_receive_byte(&g_default_parser, byte);
+}
+
+
+status_t midi_receive_span(const uint8_t* data, size_t len) {
+    return midi_parser_receive_span(&g_default_parser, data, len);
+}
+
+
+status_t midi_receive_span_timed(const uint8_t* data, const uint16_t* times,
+                                 size_t len) {
+    return midi_parser_receive_span_timed(&g_default_parser, data, times,
+                                          len);
+}
+
+
+uint16_t midi_event_time() {
+    return midi_parser_event_time(&g_default_parser);
+}
+
+
+void midi_dispatch(const midi_event_t* evt, uint16_t time) {
+    midi_parser_dispatch(&g_default_parser, evt, time);
+}
+
+
+size_t midi_receive_buffer(const uint8_t* data, size_t len,
+                           midi_event_t* out, size_t cap) {
+    return midi_parser_receive_buffer(&g_default_parser, data, len, out, cap);
 }
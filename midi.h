@@ -7,6 +7,8 @@
 #ifndef MIDI_H_INCLUDED_
 #define MIDI_H_INCLUDED_
 
+#include <stddef.h>
+#include <stdint.h>
 #include "status.h"
 
 // The baud rate for MIDI data
@@ -32,10 +34,35 @@
  */
 typedef void (*midi_event_callback_t)(char chan, char data1, char data2);
 
+/*
+ * The midi_sysex_callback_t type defines a type for the function that
+ * receives the payload of system exclusive messages (the data bytes between
+ * F0 and F7.) A message of any size is delivered as a series of chunks of
+ * at most MIDI_SYSEX_CHUNK_SIZE bytes, so it never has to be held in RAM.
+ * 
+ * Chunks point straight into the buffer being parsed (for instance, the
+ * ioport receive ring) and are valid only for the duration of the call.
+ * The first chunk of a message carries MIDI_SYSEX_START; the message is
+ * closed by a chunk with no data that carries MIDI_SYSEX_END, together with
+ * MIDI_SYSEX_ABORTED if a status byte other than F7 cut it short.
+ */
+typedef void (*midi_sysex_callback_t)(const uint8_t* data, size_t len,
+                                      unsigned char flags);
+
+#define MIDI_SYSEX_START    0x01  // First chunk of the message.
+#define MIDI_SYSEX_END      0x02  // Last chunk; the message is complete.
+#define MIDI_SYSEX_ABORTED  0x04  // The message was not terminated by F7.
+
+// Largest system exclusive chunk delivered by midi_receive_span() and
+// midi_receive_buffer(). midi_receive_byte() delivers one byte at a time.
+#ifndef MIDI_SYSEX_CHUNK_SIZE
+#define MIDI_SYSEX_CHUNK_SIZE 32
+#endif
+
 typedef enum midi_errors {
     E_MIDI_BAD_EVENT_HANDLER = -1,
     E_MIDI_BAD_CHANNEL_STATE = -2
-};
+} midi_error_t;
 
 typedef enum event_type {
     // System real-time messages
@@ -57,11 +84,189 @@ typedef enum event_type {
     EVT_CHAN_AFTERTOUCH = 13,
     EVT_CHAN_PITCH_BEND = 14,
     
+    // System common messages (SysEx is delivered by midi_sysex_callback_t.)
+    EVT_SYS_COMMON_MTC_QUARTER_FRAME = 15,
+    EVT_SYS_COMMON_SONG_POSITION = 16,
+    EVT_SYS_COMMON_SONG_SELECT = 17,
+    EVT_SYS_COMMON_TUNE_REQUEST = 18,
+    
     // Not a valid event
     EVT_MAX
 } event_type;
 
 
+/**
+ * A decoded MIDI message, as produced by midi_receive_buffer(). Fields that
+ * do not apply to the message type (the channel of a real-time or system
+ * common message, or the second data byte of a program change) are zero.
+ */
+typedef struct midi_event {
+    unsigned char type;     // Event type; see the EVT_xxx enumeration above.
+    unsigned char channel;  // MIDI channel (0-15) of a channel message.
+    unsigned char data1;    // First data byte.
+    unsigned char data2;    // Second data byte.
+} midi_event_t;
+
+
+/**
+ * Protocol state of one MIDI input: what it takes to turn bytes into events,
+ * without the event handlers. A decoder is small enough for an interrupt
+ * handler to own (see midi_decoder_decode_byte().) System exclusive payload
+ * is not an event; it goes to the decoder's sysex handler as it arrives.
+ * The members are private to the library.
+ */
+typedef struct midi_decoder {
+    // The current message: its event, its number of data bytes (zero if
+    // there is no status to apply data bytes to) and the count of data bytes
+    // still expected. Running is nonzero for a channel message, which is
+    // re-armed once complete (running status.)
+    unsigned char event;
+    unsigned char length;
+    unsigned char remaining;
+    unsigned char running;
+    
+    // System exclusive message state; nonzero between F0 and its end.
+    unsigned char sysex;
+    
+    // Updated during message parsing.
+    unsigned char channel;
+    unsigned char data1;
+    unsigned char data2;
+    
+    // Last bytes received, saved for debugging.
+    unsigned char debug_last_status_byte;
+    unsigned char debug_last_data_byte;
+    
+    midi_sysex_callback_t sysex_callback;
+} midi_decoder_t;
+
+
+/**
+ * State of one MIDI input's protocol parser: a decoder, and the handlers it
+ * dispatches events to. Each parser is independent, so several MIDI inputs
+ * can be handled at once, and on a host several parsers may run
+ * concurrently on separate threads. The members are private to the
+ * library; allocate the structure anywhere and call midi_parser_init().
+ * 
+ * The midi_xxx() functions that take no parser argument operate on a
+ * default instance held by the library.
+ */
+typedef struct midi_parser {
+    midi_decoder_t decoder;
+    
+    // Arrival time of the message being dispatched (see
+    // midi_event_time().)
+    uint16_t time;
+    
+    // Number of complete MIDI messages received.
+    unsigned long message_counter;
+    
+    // Callback table.
+    midi_event_callback_t callbacks[EVT_MAX];
+} midi_parser_t;
+
+
+/**
+ * Initialize a decoder: clear its protocol state, and set its sysex handler
+ * to discard the payload.
+ * 
+ * @param d Decoder to initialize.
+ */
+void midi_decoder_init(midi_decoder_t* d);
+
+// As midi_parser_reset(), for a decoder.
+void midi_decoder_reset(midi_decoder_t* d);
+
+// As midi_register_sysex_handler(), for a decoder.
+void midi_decoder_register_sysex_handler(midi_decoder_t* d,
+                                         midi_sysex_callback_t cb);
+
+/**
+ * Run one byte through a decoder's state machine. No callback is invoked
+ * for the event: that is left to whoever dispatches it (see
+ * midi_dispatch().) Cheap enough for an interrupt handler. A data byte of
+ * a system exclusive message goes to the decoder's sysex handler, there
+ * and then, as a chunk of its own; see midi_decoder_sysex_span() to hand
+ * over longer chunks.
+ * 
+ * @param d Decoder to run the byte through.
+ * @param byte Byte received from an input port.
+ * @param evt Receives the event, if the byte completes a message.
+ * 
+ * @return 1 if the byte completed a message, 0 otherwise.
+ */
+unsigned char midi_decoder_decode_byte(midi_decoder_t* d, unsigned char byte,
+                                       midi_event_t* evt);
+
+/**
+ * While a system exclusive message is open, hand the payload at the start
+ * of 'data' to the sysex handler in place, as one chunk of up to
+ * MIDI_SYSEX_CHUNK_SIZE bytes; the chunk ends early at a status byte.
+ * 
+ * @param d Decoder the bytes are received on.
+ * @param data Bytes received from an input port.
+ * @param len Number of bytes in 'data'.
+ * 
+ * @return Number of bytes taken; zero if no system exclusive message is
+ *         open, or 'data' starts with a status byte, which must be run
+ *         through midi_decoder_decode_byte().
+ */
+size_t midi_decoder_sysex_span(midi_decoder_t* d, const uint8_t* data,
+                               size_t len);
+
+
+/**
+ * Initialize a parser: clear its protocol state and statistics, and set all
+ * event handlers to the null handler.
+ * 
+ * @param p Parser to initialize.
+ * @return Zero on success; nonzero status otherwise.
+ */
+status_t midi_parser_init(midi_parser_t* p);
+
+/**
+ * Return a parser's protocol state to power-up (waiting for a status byte),
+ * keeping its event handlers. Useful after bytes have been lost on the input,
+ * so that stale running status is not applied to the bytes that follow.
+ * 
+ * @param p Parser to reset.
+ */
+void midi_parser_reset(midi_parser_t* p);
+
+// As midi_register_event_handler(), for a specific parser.
+status_t midi_parser_register_event_handler(midi_parser_t* p,
+                                            event_type evt,
+                                            midi_event_callback_t cb);
+
+// As midi_register_sysex_handler(), for a specific parser.
+void midi_parser_register_sysex_handler(midi_parser_t* p,
+                                        midi_sysex_callback_t cb);
+
+// As midi_receive_byte(), for a specific parser.
+status_t midi_parser_receive_byte(midi_parser_t* p, char byte);
+
+// As midi_receive_span(), for a specific parser.
+status_t midi_parser_receive_span(midi_parser_t* p,
+                                  const uint8_t* data, size_t len);
+
+// As midi_receive_span_timed(), for a specific parser.
+status_t midi_parser_receive_span_timed(midi_parser_t* p,
+                                        const uint8_t* data,
+                                        const uint16_t* times, size_t len);
+
+// As midi_event_time(), for a specific parser.
+uint16_t midi_parser_event_time(const midi_parser_t* p);
+
+// As midi_receive_buffer(), for a specific parser.
+size_t midi_parser_receive_buffer(midi_parser_t* p,
+                                  const uint8_t* data, size_t len,
+                                  midi_event_t* out, size_t cap);
+
+// As midi_dispatch(), for a specific parser.
+void midi_parser_dispatch(midi_parser_t* p, const midi_event_t* evt,
+                          uint16_t time);
+
+
 /**
  * Initialize the MIDI library. This routine must be called prior to using
  * library functions or unpredictable behavior may result.
@@ -71,6 +276,13 @@ typedef enum event_type {
 status_t midi_init();
 
 
+/**
+ * Return the protocol state of the default parser to power-up, keeping its
+ * event handlers (see midi_parser_reset().)
+ */
+void midi_reset();
+
+
 /**
  * Register an event handler for the specified event. To clear an event
  * handle, simply pass a NULL pointer for the callback argument.
@@ -85,6 +297,16 @@ status_t midi_init();
 status_t midi_register_event_handler(event_type evt, midi_event_callback_t cb);
 
 
+/**
+ * Register the handler for system exclusive payload (see
+ * midi_sysex_callback_t.) Pass a NULL pointer to discard system exclusive
+ * messages, which is the default.
+ * 
+ * @param cb Function to invoke with each chunk of payload.
+ */
+void midi_register_sysex_handler(midi_sysex_callback_t cb);
+
+
 /**
  * Processes a byte arriving via the MIDI input of the device. This function
  * *must* be invoked for every byte that arrives so that the internal state
@@ -101,4 +323,80 @@ status_t midi_register_event_handler(event_type evt, midi_event_callback_t cb);
 status_t midi_receive_byte(char byte);
 
 
+/**
+ * Processes a span of bytes arriving via the MIDI input, exactly as if each
+ * were passed to midi_receive_byte(), except that system exclusive payload
+ * is handed to the sysex handler in place, in chunks, rather than a byte at
+ * a time. The span is not modified or retained.
+ * 
+ * @param data Bytes received from an input port.
+ * @param len Number of bytes in 'data'.
+ * 
+ * @return Number of callback invocations (excluding system exclusive.)
+ */
+status_t midi_receive_span(const uint8_t* data, size_t len);
+
+
+/**
+ * As midi_receive_span(), with the arrival time of each byte (in the units
+ * of whatever clock stamped them; see clock.h.) While a callback runs,
+ * midi_event_time() returns the arrival time of the byte that completed
+ * its message.
+ * 
+ * @param data Bytes received from an input port.
+ * @param times Arrival time of each byte in 'data'.
+ * @param len Number of bytes in 'data'.
+ * 
+ * @return Number of callback invocations (excluding system exclusive.)
+ */
+status_t midi_receive_span_timed(const uint8_t* data, const uint16_t* times,
+                                 size_t len);
+
+
+/**
+ * Return the arrival time of the message whose callback is running: that
+ * of the byte that completed it, from midi_receive_span_timed(), or zero
+ * for a message received without times.
+ * 
+ * @return Arrival time of the current message.
+ */
+uint16_t midi_event_time();
+
+
+/**
+ * Invoke the handler registered for an event decoded elsewhere (for
+ * instance, by midi_decoder_decode_byte() in the receive interrupt), as if
+ * its message had just been received. While the handler runs,
+ * midi_event_time() returns 'time'. An event whose type is not valid is
+ * ignored.
+ * 
+ * @param evt Event to dispatch.
+ * @param time Arrival time of the message.
+ */
+void midi_dispatch(const midi_event_t* evt, uint16_t time);
+
+
+/**
+ * Processes a span of bytes arriving via the MIDI input, storing each
+ * complete message as an event record instead of invoking callbacks. The
+ * same state machine is used as for midi_receive_byte(), so the two may be
+ * mixed freely on one stream.
+ * 
+ * Every byte is always consumed. As with snprintf(), the return value is the
+ * number of messages decoded; if it exceeds 'cap', only the first 'cap'
+ * were stored. Since a byte completes at most one message, 'cap' >= 'len'
+ * guarantees that nothing is discarded. System exclusive payload goes to
+ * the sysex handler in place, as with midi_receive_span().
+ * 
+ * @param data Bytes received from an input port.
+ * @param len Number of bytes in 'data'.
+ * @param out Array that receives the decoded events.
+ * @param cap Number of events that 'out' can hold.
+ * 
+ * @return Number of messages decoded.
+ */
+size_t midi_receive_buffer(const uint8_t* data, size_t len,
+                           midi_event_t* out, size_t cap);
+
+
 #endif  // MIDI_H_INCLUDED_
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * ADSR envelopes and LFOs, rendered per control tick in fixed point.
+ */
+#include "modulation.h"
+
+#define LEVEL_MAX ((uint32_t) ENV_LEVEL_MAX << 16)
+
+// A quarter cycle of sine, 0 to 32767, in 64 steps; the other quarters
+// are reflections of it.
+static const int16_t SINE_QUARTER[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+
+// Change per tick to cover full scale in a number of ticks; a jump for
+// zero.
+static uint32_t stage_step(uint16_t ticks) {
+    return ticks ? LEVEL_MAX / ticks : LEVEL_MAX;
+}
+
+
+void env_init(envelope_t* env) {
+    env->level = 0;
+    env->stage = ENV_IDLE;
+    env_set(env, 0, 0, ENV_LEVEL_MAX, 0);
+}
+
+
+void env_set(envelope_t* env, uint16_t attack, uint16_t decay,
+             uint16_t sustain, uint16_t release) {
+    env->attack = stage_step(attack);
+    env->decay = stage_step(decay);
+    env->release = stage_step(release);
+    env->sustain = (uint32_t) sustain << 16;
+}
+
+
+void env_copy_times(envelope_t* env, const envelope_t* from) {
+    env->attack = from->attack;
+    env->decay = from->decay;
+    env->release = from->release;
+    env->sustain = from->sustain;
+}
+
+
+uint16_t env_render(envelope_t* env) {
+    switch (env->stage) {
+        case ENV_ATTACK:
+            if (LEVEL_MAX - env->level > env->attack) {
+                env->level += env->attack;
+                break;
+            }
+            env->level = LEVEL_MAX;
+            env->stage = ENV_DECAY;
+            break;
+
+        case ENV_DECAY:
+            if (env->level > env->sustain &&
+                env->level - env->sustain > env->decay) {
+                env->level -= env->decay;
+                break;
+            }
+            env->level = env->sustain;
+            env->stage = ENV_SUSTAIN;
+            break;
+
+        case ENV_RELEASE:
+            if (env->level > env->release) {
+                env->level -= env->release;
+                break;
+            }
+            env->level = 0;
+            env->stage = ENV_IDLE;
+            break;
+
+        case ENV_STOP:
+            env->level = 0;
+            env->stage = ENV_IDLE;
+            break;
+    }
+    return (uint16_t) (env->level >> 16);
+}
+
+
+void lfo_init(lfo_t* lfo) {
+    lfo->phase = 0;
+    lfo->rate = 0;
+    lfo->shape = LFO_SINE;
+}
+
+
+void lfo_set(lfo_t* lfo, unsigned char shape, uint16_t rate) {
+    lfo->shape = shape;
+    lfo->rate = rate;
+}
+
+
+int16_t lfo_render(lfo_t* lfo) {
+    const uint16_t phase = lfo->phase;
+    lfo->phase += lfo->rate;
+
+    switch (lfo->shape) {
+        case LFO_TRIANGLE: {
+            // Up from -32767 over the first half, down over the second.
+            const uint16_t ramp = (phase & 0x8000) ? ~phase : phase;
+            return (int16_t) ((int32_t) (ramp << 1) - 32767);
+        }
+
+        case LFO_SAW:
+            return (int16_t) ((int32_t) phase - 32768) | 1;
+
+        case LFO_SQUARE:
+            return (phase & 0x8000) ? -32767 : 32767;
+    }
+
+    // Sine: the quarter table, mirrored across each quarter.
+    const unsigned char step = (phase >> 8) & 0x3f;
+    const int16_t value = (phase & 0x4000) ? SINE_QUARTER[64 - step] :
+                                             SINE_QUARTER[step];
+    return (phase & 0x8000) ? -value : value;
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Modulation sources rendered once per control tick (TICK_HZ in config.h),
+ * from the timer interrupt: ADSR envelopes and LFOs. Both work in fixed
+ * point, with no division or multiplication per tick; the speeds are
+ * worked out when they are set.
+ *
+ * An envelope's stage is a single byte, so the main loop can open and
+ * close the gate while the interrupt renders. Its times are not: set them
+ * on a spare envelope with env_set(), whose divisions are slow, and copy
+ * them over with env_copy_times() with interrupts off (see synth.c.)
+ */
+#ifndef MODULATION_H_INCLUDED_
+#define MODULATION_H_INCLUDED_
+
+#include <stdint.h>
+
+// Full scale of an envelope: the peak of its attack.
+#define ENV_LEVEL_MAX 0xffff
+
+typedef enum env_stage {
+    ENV_IDLE = 0,       // At zero until the gate opens.
+    ENV_ATTACK = 1,
+    ENV_DECAY = 2,
+    ENV_SUSTAIN = 3,
+    ENV_RELEASE = 4,
+    ENV_STOP = 5        // Drop to zero on the next tick.
+} env_stage_t;
+
+typedef struct envelope {
+    uint32_t level;             // Output, in 1/65536 units (16.16.)
+    uint32_t attack;            // Change per tick in each stage.
+    uint32_t decay;
+    uint32_t release;
+    uint32_t sustain;           // Sustain level (16.16.)
+    volatile unsigned char stage;   // ENV_xxx
+} envelope_t;
+
+typedef enum lfo_shape {
+    LFO_SINE = 0,
+    LFO_TRIANGLE = 1,
+    LFO_SAW = 2,
+    LFO_SQUARE = 3
+} lfo_shape_t;
+
+typedef struct lfo {
+    uint16_t phase;             // Position in the cycle, 1/65536 cycles.
+    uint16_t rate;              // Phase advance per tick.
+    unsigned char shape;        // LFO_xxx
+} lfo_t;
+
+/**
+ * Initialize an envelope: idle, with instant attack, decay and release and
+ * full sustain (a gate.)
+ */
+void env_init(envelope_t* env);
+
+/**
+ * Set the times of an envelope's stages, each from full scale to zero (or
+ * zero to full scale), and its sustain level. A time of zero is a jump.
+ * Costs a division per stage.
+ *
+ * @param env Envelope to configure.
+ * @param attack Attack time, in ticks.
+ * @param decay Decay time, in ticks.
+ * @param sustain Sustain level, 0 to ENV_LEVEL_MAX.
+ * @param release Release time, in ticks.
+ */
+void env_set(envelope_t* env, uint16_t attack, uint16_t decay,
+             uint16_t sustain, uint16_t release);
+
+/**
+ * Copy the stage times and sustain level of one envelope, as set by
+ * env_set(), to another, leaving its level and stage. A few moves, for a
+ * critical section.
+ *
+ * @param env Envelope to configure.
+ * @param from Envelope to copy the times of.
+ */
+void env_copy_times(envelope_t* env, const envelope_t* from);
+
+/**
+ * Advance an envelope by one tick.
+ *
+ * @return Its level, 0 to ENV_LEVEL_MAX.
+ */
+uint16_t env_render(envelope_t* env);
+
+// Open the gate: attack from the present level, so a note that starts
+// over does not click.
+#define env_gate_on(env)   ((env)->stage = ENV_ATTACK)
+
+// Close the gate: release from the present level.
+#define env_gate_off(env)  ((env)->stage = ENV_RELEASE)
+
+// Drop to zero at once (on the next tick.)
+#define env_stop(env)      ((env)->stage = ENV_STOP)
+
+// Return nonzero once an envelope has finished its release.
+#define env_idle(env)      ((env)->stage == ENV_IDLE)
+
+/**
+ * Initialize an LFO: a sine, stopped at phase zero.
+ */
+void lfo_init(lfo_t* lfo);
+
+/**
+ * Set the shape and rate of an LFO. The frequency is
+ * rate * TICK_HZ / 65536.
+ */
+void lfo_set(lfo_t* lfo, unsigned char shape, uint16_t rate);
+
+/**
+ * Advance an LFO by one tick.
+ *
+ * @return Its output, -32767 to 32767.
+ */
+int16_t lfo_render(lfo_t* lfo);
+
+#endif  // MODULATION_H_INCLUDED_
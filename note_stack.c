@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * The keys held down, with last, low and high note priority.
+ */
+#include "note_stack.h"
+
+
+// Take a slot out of the press order and put it on the free list.
+static void release_slot(note_stack_t* stack, unsigned char slot) {
+    const unsigned char older = stack->older[slot];
+    const unsigned char newer = stack->newer[slot];
+    if (older == NOTE_NONE) {
+        stack->oldest = newer;
+    } else {
+        stack->newer[older] = newer;
+    }
+    if (newer == NOTE_NONE) {
+        stack->newest = older;
+    } else {
+        stack->older[newer] = older;
+    }
+    stack->key_slot[stack->key[slot]] = NOTE_NONE;
+    stack->newer[slot] = stack->free;
+    stack->free = slot;
+    --stack->count;
+}
+
+
+void note_stack_init(note_stack_t* stack, unsigned char priority) {
+    for (unsigned char key = 0; key < 128; ++key) {
+        stack->key_slot[key] = NOTE_NONE;
+    }
+    for (unsigned char slot = 0; slot < NOTE_STACK_SIZE; ++slot) {
+        stack->newer[slot] = slot + 1;
+    }
+    stack->newer[NOTE_STACK_SIZE - 1] = NOTE_NONE;
+    stack->free = 0;
+    stack->oldest = NOTE_NONE;
+    stack->newest = NOTE_NONE;
+    stack->count = 0;
+    stack->priority = priority;
+}
+
+
+void note_stack_push(note_stack_t* stack, unsigned char key) {
+    key &= 0x7f;
+
+    // A key pressed again (it can be, if its note off was lost) moves to
+    // the top. With every slot in use, the oldest key is dropped.
+    if (stack->key_slot[key] != NOTE_NONE) {
+        release_slot(stack, stack->key_slot[key]);
+    } else if (stack->free == NOTE_NONE) {
+        release_slot(stack, stack->oldest);
+    }
+
+    const unsigned char slot = stack->free;
+    stack->free = stack->newer[slot];
+    stack->key[slot] = key;
+    stack->older[slot] = stack->newest;
+    stack->newer[slot] = NOTE_NONE;
+    if (stack->newest == NOTE_NONE) {
+        stack->oldest = slot;
+    } else {
+        stack->newer[stack->newest] = slot;
+    }
+    stack->newest = slot;
+    stack->key_slot[key] = slot;
+    ++stack->count;
+}
+
+
+unsigned char note_stack_remove(note_stack_t* stack, unsigned char key) {
+    const unsigned char slot = stack->key_slot[key & 0x7f];
+    if (slot == NOTE_NONE) {
+        return 0;
+    }
+    release_slot(stack, slot);
+    return 1;
+}
+
+
+unsigned char note_stack_current(const note_stack_t* stack) {
+    if (stack->newest == NOTE_NONE) {
+        return NOTE_NONE;
+    }
+    unsigned char best = stack->key[stack->newest];
+    if (stack->priority == NOTE_PRIORITY_LAST) {
+        return best;
+    }
+
+    // Look at each of the other keys held.
+    for (unsigned char slot = stack->older[stack->newest]; slot != NOTE_NONE;
+         slot = stack->older[slot]) {
+        const unsigned char key = stack->key[slot];
+        if ((stack->priority == NOTE_PRIORITY_LOW) ? (key < best) :
+                                                     (key > best)) {
+            best = key;
+        }
+    }
+    return best;
+}
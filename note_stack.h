@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * The keys held down, for playing one note at a time (unison mode.) The
+ * note that plays is chosen from them by priority:
+ *
+ *   NOTE_PRIORITY_LAST  - The key pressed most recently.
+ *   NOTE_PRIORITY_LOW   - The lowest key held.
+ *   NOTE_PRIORITY_HIGH  - The highest key held.
+ *
+ * so that releasing a key returns to one still held. Keys are kept in the
+ * order pressed, in a list linked through slots that a map from each key
+ * finds directly: pushing and removing a key take constant time, and
+ * choosing by low or high priority looks only at the keys held. Nothing is
+ * allocated; with NOTE_STACK_SIZE keys held, the oldest is dropped to make
+ * room for a new one.
+ */
+#ifndef NOTE_STACK_H_INCLUDED_
+#define NOTE_STACK_H_INCLUDED_
+
+// Most keys held at once.
+#define NOTE_STACK_SIZE 16
+
+// Returned, and held in the links and key map, where there is no key.
+#define NOTE_NONE 0xff
+
+typedef enum note_priority {
+    NOTE_PRIORITY_LAST = 0,
+    NOTE_PRIORITY_LOW = 1,
+    NOTE_PRIORITY_HIGH = 2
+} note_priority_t;
+
+typedef struct note_stack {
+    unsigned char key_slot[128];            // Slot of each key held.
+    unsigned char key[NOTE_STACK_SIZE];     // Key in each slot.
+    unsigned char older[NOTE_STACK_SIZE];   // Links in press order; free
+    unsigned char newer[NOTE_STACK_SIZE];   // slots are linked by newer.
+    unsigned char oldest;
+    unsigned char newest;
+    unsigned char free;                     // First free slot.
+    unsigned char count;                    // Keys held.
+    unsigned char priority;                 // NOTE_PRIORITY_xxx
+} note_stack_t;
+
+/**
+ * Initialize a note stack with no keys held.
+ *
+ * @param stack Stack to initialize.
+ * @param priority NOTE_PRIORITY_xxx
+ */
+void note_stack_init(note_stack_t* stack, unsigned char priority);
+
+/**
+ * Add a key pressed. A key already held moves to the top.
+ */
+void note_stack_push(note_stack_t* stack, unsigned char key);
+
+/**
+ * Remove a key released.
+ *
+ * @return Nonzero if the key was held.
+ */
+unsigned char note_stack_remove(note_stack_t* stack, unsigned char key);
+
+/**
+ * Return the key that should play, by priority, or NOTE_NONE if no key is
+ * held.
+ */
+unsigned char note_stack_current(const note_stack_t* stack);
+
+// Return the number of keys held.
+#define note_stack_count(stack) ((stack)->count)
+
+#endif  // NOTE_STACK_H_INCLUDED_
@@ -0,0 +1,49 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * Oscillator pitch, and its conversion to 8254 divisors by table lookup.
+ */
+#include "pitch.h"
+
+#define EXP_FRACTION_MASK ((1 << PITCH_EXP_BITS) - 1)
+
+
+uint16_t pitch_to_divisor(pitch_t pitch) {
+    if (pitch < PITCH_MIN) {
+        pitch = PITCH_MIN;
+    } else if (pitch > PITCH_MAX) {
+        pitch = PITCH_MAX;
+    }
+    
+    // Split the pitch into whole octaves above the table and a place
+    // within the octave.
+    uint16_t offset = pitch - PITCH_MIN;
+    const unsigned char octave = PITCH_OCTAVE[offset >> PITCH_FRACTION_BITS];
+    offset -= octave * PITCH_STEPS_PER_OCTAVE;
+    
+    // Interpolate between the table entries either side.
+    const uint16_t* entry = &PITCH_EXP_TABLE[offset >> PITCH_EXP_BITS];
+    const unsigned char step = (unsigned char) (entry[0] - entry[1]);
+    const unsigned char fraction = offset & EXP_FRACTION_MASK;
+    uint16_t divisor = entry[0] -
+        (((uint16_t) step * fraction + (1 << (PITCH_EXP_BITS - 1))) >>
+         PITCH_EXP_BITS);
+    
+    // Each octave up halves the divisor (rounding to nearest.)
+    if (octave) {
+        divisor = (divisor + (1 << (octave - 1))) >> octave;
+    }
+    return divisor;
+}
+
+
+pitch_t pitch_add(pitch_t pitch, int offset) {
+    const long sum = (long) pitch + offset;
+    if (sum < 0) {
+        return 0;
+    } else if (sum > PITCH_MAX) {
+        return PITCH_MAX;
+    }
+    return (pitch_t) sum;
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * Oscillator pitch, and its conversion to 8254 divisors by table lookup.
+ *
+ * Pitch is kept in the log domain, in fixed point: the high bits are the
+ * MIDI note number and the low PITCH_FRACTION_BITS bits are fractions of a
+ * semitone above it. Musical offsets (bend, detune, vibrato) are therefore
+ * plain additions, and are the same interval at any pitch.
+ *
+ * Converting a pitch to a divisor is a single exponential lookup: the
+ * pitch's place within its octave indexes a table of divisors for the
+ * lowest octave, which is interpolated and then halved once per octave
+ * above. There is no division at run time. The tables (pitch_tables.c) are
+ * generated on the build host for INTEL8254_CLOCK_HZ by
+ * host/gen_pitch_tables.c.
+ */
+#ifndef PITCH_H_INCLUDED_
+#define PITCH_H_INCLUDED_
+
+#include <stdint.h>
+
+// Fractional bits of a pitch; 256 steps per semitone (about 0.4 cents.)
+#define PITCH_FRACTION_BITS 8
+#define PITCH_STEPS_PER_SEMITONE (1 << PITCH_FRACTION_BITS)
+#define PITCH_STEPS_PER_OCTAVE (12 * PITCH_STEPS_PER_SEMITONE)
+
+// Highest representable pitch (the top step of MIDI note 127.)
+#define PITCH_MAX ((pitch_t) ((128 << PITCH_FRACTION_BITS) - 1))
+
+// Pitch of a MIDI note number.
+#define PITCH_FROM_NOTE(note) \
+    ((pitch_t) (((note) & 0x7f) << PITCH_FRACTION_BITS))
+
+// The exponential table has an entry every 2^PITCH_EXP_BITS steps, over one
+// octave and the first entry of the next.
+#define PITCH_EXP_BITS 4
+#define PITCH_EXP_SIZE ((PITCH_STEPS_PER_OCTAVE >> PITCH_EXP_BITS) + 1)
+
+typedef uint16_t pitch_t;
+
+/*
+ * Generated tables (pitch_tables.c.)
+ */
+
+// Lowest pitch whose divisor fits in the 16-bit counter.
+extern const pitch_t PITCH_MIN;
+
+// Divisors for the octave starting at PITCH_MIN; entry i is the divisor of
+// PITCH_MIN + (i << PITCH_EXP_BITS). Adjacent entries differ by less than
+// 256, so interpolation needs only an 8 x 8 multiply.
+extern const uint16_t PITCH_EXP_TABLE[PITCH_EXP_SIZE];
+
+// Octave above PITCH_MIN of each semitone above it.
+extern const unsigned char PITCH_OCTAVE[128];
+
+/**
+ * Return the 8254 divisor that produces a pitch. Pitches outside the range
+ * PITCH_MIN to PITCH_MAX are clamped to it.
+ *
+ * @param pitch Pitch, in semitones above MIDI note 0 (see above.)
+ * @return Divisor to load into a counter.
+ */
+uint16_t pitch_to_divisor(pitch_t pitch);
+
+/**
+ * Offset a pitch, saturating at 0 and PITCH_MAX.
+ *
+ * @param pitch Pitch to offset.
+ * @param offset Offset in pitch steps; negative is down.
+ * @return The offset pitch.
+ */
+pitch_t pitch_add(pitch_t pitch, int offset);
+
+#endif  // PITCH_H_INCLUDED_
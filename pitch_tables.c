@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Pitch tables for an 8254 clock of 2000000 Hz (see pitch.h.)
+ *
+ * GENERATED by host/gen_pitch_tables.c from config.h; do not edit.
+ */
+#include "pitch.h"
+
+const pitch_t PITCH_MIN = 23 << PITCH_FRACTION_BITS;  // B0, 30.87 Hz
+
+const uint16_t PITCH_EXP_TABLE[PITCH_EXP_SIZE] = {
+    // B0
+    64793, 64559, 64326, 64095, 63864, 63634, 63404, 63176,
+    62948, 62721, 62495, 62270, 62046, 61822, 61599, 61377,
+    // C1
+    61156, 60936, 60716, 60497, 60279, 60062, 59846, 59630,
+    59415, 59201, 58988, 58775, 58563, 58352, 58142, 57932,
+    // C#1
+    57724, 57516, 57308, 57102, 56896, 56691, 56487, 56283,
+    56080, 55878, 55677, 55476, 55276, 55077, 54879, 54681,
+    // D1
+    54484, 54288, 54092, 53897, 53703, 53509, 53316, 53124,
+    52933, 52742, 52552, 52363, 52174, 51986, 51799, 51612,
+    // D#1
+    51426, 51241, 51056, 50872, 50689, 50506, 50324, 50143,
+    49962, 49782, 49603, 49424, 49246, 49068, 48891, 48715,
+    // E1
+    48540, 48365, 48190, 48017, 47844, 47671, 47500, 47328,
+    47158, 46988, 46819, 46650, 46482, 46314, 46147, 45981,
+    // F1
+    45815, 45650, 45486, 45322, 45158, 44996, 44834, 44672,
+    44511, 44351, 44191, 44032, 43873, 43715, 43557, 43400,
+    // F#1
+    43244, 43088, 42933, 42778, 42624, 42470, 42317, 42165,
+    42013, 41861, 41711, 41560, 41410, 41261, 41113, 40964,
+    // G1
+    40817, 40670, 40523, 40377, 40232, 40087, 39942, 39798,
+    39655, 39512, 39370, 39228, 39086, 38945, 38805, 38665,
+    // G#1
+    38526, 38387, 38249, 38111, 37974, 37837, 37700, 37565,
+    37429, 37294, 37160, 37026, 36893, 36760, 36627, 36495,
+    // A1
+    36364, 36233, 36102, 35972, 35842, 35713, 35584, 35456,
+    35328, 35201, 35074, 34948, 34822, 34696, 34571, 34447,
+    // A#1
+    34323, 34199, 34076, 33953, 33831, 33709, 33587, 33466,
+    33346, 33225, 33106, 32986, 32868, 32749, 32631, 32513,
+    // B1
+    32396
+};
+
+const unsigned char PITCH_OCTAVE[128] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+     5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,
+     6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,
+     7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,
+     8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+    10, 10, 10, 10, 10, 10, 10, 10
+};
@@ -0,0 +1,145 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Cooperative, prioritized task scheduler with per-task run time budgets.
+ */
+#include "sched.h"
+#include "hal.h"
+
+static sched_task_t* g_tasks = 0;
+static unsigned char g_task_count = 0;
+
+// Control ticks, counted by the interrupt; a single byte is read
+// atomically.
+static volatile unsigned char g_ticks = 0;
+
+// When the running task started, and its budget.
+static unsigned char g_start_ticks = 0;
+static unsigned char g_start_counts = 0;
+static uint16_t g_budget = 0;
+
+
+// Read the tick count and the tick timer together: again if a tick
+// interrupt came in between.
+static void read_time(unsigned char* ticks, unsigned char* counts) {
+    do {
+        *ticks = g_ticks;
+        *counts = HAL_TICK_ELAPSED();
+    } while (*ticks != g_ticks);
+}
+
+// Counts since the running task started.
+static uint16_t since_start(void) {
+    unsigned char ticks = 0;
+    unsigned char counts = 0;
+    read_time(&ticks, &counts);
+    return (unsigned char) (ticks - g_start_ticks) * SCHED_COUNTS_PER_TICK +
+           counts - g_start_counts;
+}
+
+static unsigned char is_ready(sched_task_t* task) {
+    if (task->ready) {
+        return task->ready();
+    }
+    return (unsigned char) (g_ticks - task->last) >= task->period;
+}
+
+// Run a task, and account for it; return nonzero if it yielded.
+static unsigned char run(sched_task_t* task) {
+    read_time(&g_start_ticks, &g_start_counts);
+    g_budget = task->budget;
+    if (!task->ready) {
+        const unsigned char late =
+            (unsigned char) (g_start_ticks - task->last) - task->period;
+        if (late > task->deadline) {
+            ++task->misses;
+        }
+        task->last = g_start_ticks;
+    }
+
+    const unsigned char more = task->run();
+
+    const uint16_t spent = since_start();
+    ++task->runs;
+    if (spent > task->worst) {
+        task->worst = spent;
+    }
+    if (spent > task->budget) {
+        ++task->overruns;
+    }
+    return more;
+}
+
+
+void sched_init(sched_task_t* tasks, unsigned char count) {
+    g_tasks = tasks;
+    g_task_count = count;
+    for (unsigned char i = 0; i < count; ++i) {
+        tasks[i].last = g_ticks;
+    }
+    sched_reset_stats();
+}
+
+
+void sched_run(void) {
+    unsigned char i = 0;
+    while (i < g_task_count) {
+        sched_task_t* task = &g_tasks[i];
+        if (!is_ready(task)) {
+            ++i;
+            continue;
+        }
+
+        // Start again from the top, unless the task yielded: then the
+        // tasks below it go first.
+        i = run(task) ? i + 1 : 0;
+    }
+}
+
+
+void sched_tick_isr(void) {
+    ++g_ticks;
+}
+
+
+unsigned char sched_ticks(void) {
+    return g_ticks;
+}
+
+
+unsigned char sched_over_budget(void) {
+    return since_start() > g_budget;
+}
+
+
+uint16_t sched_blocking(unsigned char task) {
+    uint16_t worst = 0;
+    for (unsigned char i = task + 1; i < g_task_count; ++i) {
+        if (g_tasks[i].worst > worst) {
+            worst = g_tasks[i].worst;
+        }
+    }
+    return worst;
+}
+
+
+const sched_task_t* sched_task(unsigned char task) {
+    return &g_tasks[task];
+}
+
+
+unsigned char sched_task_count(void) {
+    return g_task_count;
+}
+
+
+void sched_reset_stats(void) {
+    for (unsigned char i = 0; i < g_task_count; ++i) {
+        sched_task_t* task = &g_tasks[i];
+        task->runs = 0;
+        task->worst = 0;
+        task->overruns = 0;
+        task->misses = 0;
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Cooperative scheduler for the main loop. Tasks are kept in priority
+ * order, highest first. Each pass runs the first task that is ready and
+ * then starts again from the top, so a task waits for at most one run of
+ * a task below it: the longest of those bounds the latency of the first.
+ *
+ * A task is ready when its ready() function says so or, without one, when
+ * its period in control ticks has elapsed since it last ran. A periodic
+ * task that starts more than its deadline in ticks after it fell due has
+ * missed it. A task that has work left when it has used its budget (see
+ * sched_over_budget()) returns nonzero, and the tasks below it are given
+ * their turn before it runs again.
+ *
+ * Run times are measured against the tick timer, in units of 16 Tcy (see
+ * HAL_TICK_ELAPSED()), and the worst of each task is kept.
+ */
+#ifndef SCHED_H_INCLUDED_
+#define SCHED_H_INCLUDED_
+
+#include <stdint.h>
+#include "config.h"
+
+// Counts of the tick timer per tick, each 16 Tcy.
+#define SCHED_COUNTS_PER_TICK ((uint16_t) (_XTAL_FREQ / 4 / 16 / TICK_HZ))
+
+// Budget for a number of Tcy, in counts.
+#define SCHED_TCY(tcy) ((uint16_t) ((tcy) / 16))
+
+typedef struct sched_task {
+    const char* name;
+    unsigned char (*run)(void);     // Nonzero: yielded with work left.
+    unsigned char (*ready)(void);   // Or 0 for a periodic task.
+    unsigned char period;           // Ticks.
+    unsigned char deadline;         // Ticks late before a miss.
+    uint16_t budget;                // Counts (SCHED_TCY().)
+
+    // Run state and statistics.
+    unsigned char last;             // Tick of the last run.
+    unsigned long runs;
+    uint16_t worst;                 // Longest run, in counts.
+    unsigned long overruns;         // Runs over budget.
+    unsigned long misses;           // Deadlines missed.
+} sched_task_t;
+
+/**
+ * Set the tasks to schedule, highest priority first, and clear their
+ * statistics. The array must outlive the scheduler.
+ *
+ * @param tasks Tasks, in priority order.
+ * @param count Number of tasks.
+ */
+void sched_init(sched_task_t* tasks, unsigned char count);
+
+/**
+ * Run tasks, highest priority first, until none is ready.
+ */
+void sched_run(void);
+
+/**
+ * Count a control tick; called from the timer interrupt.
+ */
+void sched_tick_isr(void);
+
+/**
+ * Return the control ticks counted, modulo 256.
+ */
+unsigned char sched_ticks(void);
+
+/**
+ * Return nonzero once the running task has used its budget, for a task
+ * that does its work in pieces to yield.
+ */
+unsigned char sched_over_budget(void);
+
+/**
+ * Return the longest a task could wait behind the tasks below it, in
+ * counts: the worst run of any of them.
+ *
+ * @param task Index of the task.
+ */
+uint16_t sched_blocking(unsigned char task);
+
+/**
+ * Return a task, for its statistics.
+ *
+ * @param task Index of the task.
+ */
+const sched_task_t* sched_task(unsigned char task);
+
+/**
+ * Return the number of tasks.
+ */
+unsigned char sched_task_count(void);
+
+/**
+ * Clear the statistics of every task.
+ */
+void sched_reset_stats(void);
+
+#endif  // SCHED_H_INCLUDED_
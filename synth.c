@@ -0,0 +1,780 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * The synthesizer application: MIDI event handlers, oscillator control and
+ * the main event loop. This is kept apart from main.c, which holds only the
+ * device configuration and entry point, so that it can also be built and
+ * exercised on a host computer (see host/.)
+ */
+#include "synth.h"
+#include "clock.h"
+#include "config.h"
+#include "dac.h"
+#include "display.h"
+#include "eventq.h"
+#include "glide.h"
+#include "hal.h"
+#include "intel8254.h"
+#include "ioport.h"
+#include "midi.h"
+#include "modulation.h"
+#include "note_stack.h"
+#include "pitch.h"
+#include "sched.h"
+#include "tuning.h"
+#include "voice.h"
+
+#if INTEL8254_COUNTERS > VOICE_MAX
+#error "More 8254 counters than voices"
+#endif
+
+
+// Keys currently depressed (AKA notes on), and in unison mode, the key
+// chosen from them that is playing (NOTE_NONE while silent.) With legato
+// on (CC 68), a change of key while others are held carries on the note
+// that is sounding, gliding with portamento on; with it off, each change
+// starts the note over.
+static note_stack_t g_notes;
+static unsigned char g_note_on_key = NOTE_NONE;
+static unsigned char g_legato = 1;
+
+// Voice mode (VOICE_MODE_xxx). In unison mode every oscillator plays the
+// note on, detuned; in poly mode each plays a voice of its own, allocated
+// by g_voices, at the pitch and divisor of that voice's key.
+static unsigned char g_voice_mode = VOICE_MODE_UNISON;
+static voice_alloc_t g_voices;
+static pitch_t g_voice_pitch[INTEL8254_COUNTERS];
+static uint16_t g_voice_divisor[INTEL8254_COUNTERS];
+
+// The control tick count (see sched_ticks()) when the glide last caught up
+// with it; the difference is right across wrap.
+static unsigned char g_ticks_seen = 0;
+
+/*
+ * Each oscillator's pitch is the sum of these sources, all in pitch steps
+ * (see pitch.h), which update_oscillators() combines once per update.
+ */
+
+// The pitch of the note on, from the selected tuning, and its exact
+// divisor.
+static pitch_t g_note_on_pitch = PITCH_MAX;
+static uint16_t g_note_on_divisor = 0;
+
+// Portamento: the pitch that is playing glides to each new note played
+// legato while it is enabled (with CC 65), at the
+// speed set by CC 5.
+static glide_t g_glide;
+static unsigned char g_portamento = 0;
+
+// Pitch bend offset (the wheel spans one octave either way.)
+static int g_pitch_bend = 0;
+
+// Modulation (vibrato) offset, common to all oscillators.
+static int g_pitch_mod = 0;
+
+// Set when a pitch source has changed since the last update.
+static unsigned char g_pitch_changed = 0;
+
+// Active sensing. Once a sender has sent it (FE), a silence of more than
+// 300 ms on the input means the connection has been lost, and every note
+// is silenced, so that none drones on for want of its note off. The tick
+// interrupt counts the ticks in which the receive interrupt took no byte,
+// so parsing does no work for it; the watchdog task does the silencing,
+// which writes the 8254s. g_sensing is armed by FE and disarmed by a
+// timeout or reset; g_sensing_lost is set by the interrupt.
+#define SENSING_TICKS ((uint16_t) (300UL * TICK_HZ / 1000))
+static volatile unsigned char g_sensing = 0;
+static volatile unsigned char g_sensing_lost = 0;
+static unsigned char g_rx_seen = 0;
+static uint16_t g_quiet_ticks = 0;
+
+/*
+ * Modulation, rendered by the timer interrupt each tick. The envelope
+ * drives the VCA from DAC channel DAC_VCA, and the LFO is output on
+ * DAC_LFO (about mid scale) and is vibrato, at a depth set by the mod
+ * wheel. The DAC driver sends only codes that change. The interrupt
+ * leaves the top byte of the LFO in g_lfo_out for task_modulation() to
+ * read (a single byte is read atomically.) The envelope times and sustain
+ * level are kept here, as set, for env_set().
+ */
+#define LFO_DEFAULT_RATE ((uint16_t) (5UL * 65536 / TICK_HZ))
+static envelope_t g_env;
+static lfo_t g_lfo;
+static uint16_t g_env_attack = 0;
+static uint16_t g_env_decay = 0;
+static uint16_t g_env_sustain = ENV_LEVEL_MAX;
+static uint16_t g_env_release = 0;
+static volatile signed char g_lfo_out = 0;
+static unsigned char g_vibrato_depth = 0;
+
+// Set in unison mode while the last note is releasing: the oscillators
+// play on until the envelope has finished.
+static unsigned char g_releasing = 0;
+
+// Longest time from a tick to the end of rendering it, in units of 16 Tcy
+// (see HAL_TICK_ELAPSED().)
+static volatile unsigned char g_render_peak = 0;
+
+// Time from the arrival of the last note on to its 8254 write, and the
+// longest, in microseconds (see clock.h.)
+static uint16_t g_note_latency = 0;
+static uint16_t g_note_latency_peak = 0;
+
+// DAC channels (see dac.h.)
+#define DAC_VCA 0
+#define DAC_LFO 1
+
+// The LFO (-128 to 127) times the mod wheel depth (0 to 127), shifted
+// right this far, gives the vibrato offset: at most about a semitone.
+#define VIBRATO_SHIFT 6
+
+// Fixed detune of the oscillators of each chip; the second is about 39
+// cents sharp (10 Hz at A4) at any pitch. There is an oscillator per
+// counter on the bus (INTEL8254_COUNTERS.)
+static const int OSC_DETUNE[3] = { 0, PITCH_STEPS_PER_SEMITONE * 2 / 5, 0 };
+
+// Divisor that silences an oscillator (its output is far above audio.)
+#define OSC_DIVISOR_SILENT 1
+
+
+void set_oscillator_divisor(int osc, uint16_t divisor, unsigned char start);
+
+// Silence every oscillator and forget the notes and voices playing.
+static void all_notes_off() {
+    for (unsigned char osc = 0; osc < INTEL8254_COUNTERS; ++osc) {
+        set_oscillator_divisor(osc, OSC_DIVISOR_SILENT, 0);
+    }
+    g_note_on_key = NOTE_NONE;
+    g_releasing = 0;
+    env_stop(&g_env);
+    g_note_on_pitch = PITCH_MAX;
+    g_note_on_divisor = 0;
+    glide_jump(&g_glide, PITCH_MAX);
+    if (note_stack_count(&g_notes)) {
+        note_stack_init(&g_notes, g_notes.priority);
+    }
+    if (g_voices.playing) {
+        voice_init(&g_voices, INTEL8254_COUNTERS, g_voices.steal);
+    }
+}
+
+void update_oscillators(unsigned char start);
+
+// Play a key in unison mode. Played legato, the pitch glides from the one
+// sounding when portamento is on, or else jumps to it. A note that starts
+// over jumps, and may reprogram the counters; on key down, that does not
+// click.
+static void play_note(unsigned char key, unsigned char legato) {
+    const tuning_t* tuning = tuning_current();
+    g_note_on_key = key;
+    g_note_on_pitch = tuning->pitch[key];
+    g_note_on_divisor = tuning->divisor[key];
+    g_releasing = 0;
+    if (legato) {
+        if (g_portamento) {
+            glide_to(&g_glide, g_note_on_pitch);
+        } else {
+            glide_jump(&g_glide, g_note_on_pitch);
+        }
+        update_oscillators(0);
+    } else {
+        glide_jump(&g_glide, g_note_on_pitch);
+        update_oscillators(1);
+        env_gate_on(&g_env);
+    }
+}
+
+// A key released in unison mode: the note goes back to the key that now
+// has priority, or with the last key up, releases; task_modulation()
+// silences the oscillators when the envelope has finished.
+static void on_note_off(unsigned char key) {
+    note_stack_remove(&g_notes, key);
+    if (note_stack_count(&g_notes) == 0) {
+        if (g_note_on_key == NOTE_NONE) {
+            all_notes_off();
+        } else {
+            env_gate_off(&g_env);
+            g_releasing = 1;
+        }
+        return;
+    }
+    const unsigned char next = note_stack_current(&g_notes);
+    if (next != g_note_on_key) {
+        play_note(next, g_legato);
+    }
+}
+
+// Release every note: in unison mode, as if the last key were up; in poly
+// mode, where a voice is silenced at its note off, all at once.
+static void release_all_notes() {
+    if (g_voice_mode == VOICE_MODE_UNISON && g_note_on_key != NOTE_NONE) {
+        note_stack_init(&g_notes, g_notes.priority);
+        env_gate_off(&g_env);
+        g_releasing = 1;
+        return;
+    }
+    all_notes_off();
+}
+
+void on_midi_active_sensing(char chan, char data1, char data2) {
+    // The sender will now send something at least every 300 ms, until it
+    // is reset; the tick interrupt watches for the silence.
+    g_sensing = 1;
+}
+
+
+// Put the settings that MIDI can change back to their power-up values:
+// unison mode with last note priority, legato, the wheels centered,
+// nothing gliding until portamento is enabled, vibrato off, the first
+// tuning, and active sensing not expected. The envelope and LFO, which
+// the tick interrupt renders from, are left to the caller.
+static void default_settings(void) {
+    g_voice_mode = VOICE_MODE_UNISON;
+    g_voices.steal = VOICE_STEAL_OLDEST;
+    g_notes.priority = NOTE_PRIORITY_LAST;
+    g_legato = 1;
+    g_pitch_bend = 0;
+    g_pitch_mod = 0;
+    g_pitch_changed = 1;
+    g_portamento = 0;
+    glide_set_time(&g_glide, GLIDE_MODE_TIME, 0);
+    g_vibrato_depth = 0;
+    g_sensing = 0;
+    tuning_select(0);
+}
+
+
+void on_midi_reset(char chan, char data1, char data2) {
+    // Back to power-up: silence, then every setting as system_init()
+    // leaves it.
+    all_notes_off();
+    default_settings();
+    set_envelope(0, 0, ENV_LEVEL_MAX, 0);
+    set_lfo(LFO_SINE, LFO_DEFAULT_RATE);
+}
+
+
+void on_midi_note_off(char chan, char key, char val) {
+    // Turn off LED for note off.
+    HAL_LED_NOTE(0);
+    if (g_voice_mode == VOICE_MODE_POLY) {
+        // Only the oscillator of the key's voice stops, if it still has
+        // one.
+        const unsigned char v = voice_note_off(&g_voices, key);
+        if (v != VOICE_NONE) {
+            set_oscillator_divisor(v, OSC_DIVISOR_SILENT, 0);
+        }
+        if (g_voices.playing == 0) {
+            env_gate_off(&g_env);
+        }
+        return;
+    }
+    on_note_off(key & 0x7f);
+}
+
+// Bend wheel positions this close to center play the note unbent.
+#define BEND_DEAD_ZONE 20
+
+// Convert a bend wheel position to a pitch offset. The wheel spans one
+// octave either way: 8192 wheel units to 12 semitones, or
+// 12 << PITCH_FRACTION_BITS pitch steps, is a factor of
+// 3 >> (11 - PITCH_FRACTION_BITS).
+int calc_pitch_bend(long bender) {
+    if ((bender < (8192 - BEND_DEAD_ZONE)) ||
+        (bender > (8192 + BEND_DEAD_ZONE))) {
+        return (int) (((bender - 8192) * 3) >> (11 - PITCH_FRACTION_BITS));
+    }
+    return 0;
+}
+
+
+// Load a divisor into an oscillator's counter; 'start' is set for a note
+// that is starting, where the counter may be reprogrammed (see
+// intel8254.h.) The driver skips divisors that are already loaded.
+void set_oscillator_divisor(int osc, uint16_t divisor, unsigned char start) {
+    const char lsb = (unsigned char) (divisor & 0xff);
+    const char msb = (unsigned char) (divisor >> 8);
+    if (start) {
+        intel_start_timer(osc, lsb, msb);
+    } else {
+        intel_write_timer(osc, lsb, msb);
+    }
+}
+
+
+// Sum the pitch sources for an oscillator: the note on (in unison mode,
+// gliding and detuned) or its voice's note (in poly mode), and the bend and
+// modulation offset. Where the sum is exactly the note, the tuning's
+// divisor is used as is. An oscillator with no voice is silent.
+static uint16_t oscillator_divisor(unsigned char osc, int offset) {
+    if (g_voice_mode == VOICE_MODE_POLY) {
+        if (voice_key(&g_voices, osc) == VOICE_NO_KEY) {
+            return OSC_DIVISOR_SILENT;
+        }
+        if (offset == 0 && g_voice_divisor[osc]) {
+            return g_voice_divisor[osc];
+        }
+        return pitch_to_divisor(pitch_add(g_voice_pitch[osc], offset));
+    }
+
+    const pitch_t pitch = pitch_add(glide_pitch(&g_glide),
+                                    OSC_DETUNE[osc % 3] + offset);
+    if (pitch == g_note_on_pitch && g_note_on_divisor) {
+        return g_note_on_divisor;
+    }
+    return pitch_to_divisor(pitch);
+}
+
+// Work out the divisor of each oscillator and load them. All the divisors
+// are worked out first and then loaded together, so that the oscillators
+// change pitch at the same moment.
+void update_oscillators(unsigned char start) {
+    const int offset = g_pitch_bend + g_pitch_mod;
+    uint16_t divisors[INTEL8254_COUNTERS];
+    g_pitch_changed = 0;
+    for (unsigned char osc = 0; osc < INTEL8254_COUNTERS; ++osc) {
+        divisors[osc] = oscillator_divisor(osc, offset);
+    }
+    if (start) {
+        for (unsigned char osc = 0; osc < INTEL8254_COUNTERS; ++osc) {
+            set_oscillator_divisor(osc, divisors[osc], 1);
+        }
+    } else {
+        intel_write_timers(divisors);
+    }
+}
+
+
+void set_pitch_modulation(int offset) {
+    g_pitch_changed |= (offset != g_pitch_mod);
+    g_pitch_mod = offset;
+}
+
+
+void set_portamento(unsigned char mode, uint16_t ticks) {
+    glide_set_time(&g_glide, mode, ticks);
+}
+
+
+void set_note_priority(unsigned char priority, unsigned char legato) {
+    g_notes.priority = priority;
+    g_legato = legato;
+}
+
+
+void set_voice_mode(unsigned char mode, unsigned char steal) {
+    all_notes_off();
+    g_voice_mode = mode;
+    g_voices.steal = steal;
+}
+
+
+void set_envelope(uint16_t attack, uint16_t decay, uint16_t sustain,
+                  uint16_t release) {
+    g_env_attack = attack;
+    g_env_decay = decay;
+    g_env_sustain = sustain;
+    g_env_release = release;
+
+    // Divide with interrupts on; the interrupt must not render from a
+    // half-written envelope, so only the copy is done with them off.
+    envelope_t times;
+    env_set(&times, attack, decay, sustain, release);
+    HAL_IRQ_DISABLE();
+    env_copy_times(&g_env, &times);
+    HAL_IRQ_ENABLE();
+}
+
+
+void set_lfo(unsigned char shape, uint16_t rate) {
+    HAL_IRQ_DISABLE();
+    lfo_set(&g_lfo, shape, rate);
+    HAL_IRQ_ENABLE();
+}
+
+
+uint16_t synth_render_peak() {
+    return (uint16_t) g_render_peak * 16;
+}
+
+
+uint16_t synth_note_latency(unsigned char peak) {
+    return peak ? g_note_latency_peak : g_note_latency;
+}
+
+
+// A note on has been written to the 8254s: account for the time since it
+// arrived.
+static void note_written(void) {
+    g_note_latency = clock_now16() - midi_event_time();
+    if (g_note_latency > g_note_latency_peak) {
+        g_note_latency_peak = g_note_latency;
+    }
+}
+
+
+void synth_tick_isr() {
+    sched_tick_isr();
+    
+    // Active sensing: count the ticks since a byte came in.
+    const unsigned char rx = ioport_rx_count();
+    if (rx != g_rx_seen) {
+        g_rx_seen = rx;
+        g_quiet_ticks = 0;
+    } else if (g_quiet_ticks < SENSING_TICKS &&
+               ++g_quiet_ticks == SENSING_TICKS && g_sensing) {
+        g_sensing_lost = 1;
+    }
+
+    // Render the modulators, and queue their codes for the DAC, which
+    // sends only those that change: while the envelope sustains or is
+    // idle, nothing is sent for it. The queue is sent by the SSP interrupt.
+    const int16_t lfo = lfo_render(&g_lfo);
+    g_lfo_out = (signed char) (lfo >> 8);
+    dac_write(DAC_VCA, env_render(&g_env) >> 4);
+    dac_write(DAC_LFO, (uint16_t) ((lfo >> 4) + 2048));
+
+    const unsigned char spent = HAL_TICK_ELAPSED();
+    if (spent > g_render_peak) {
+        g_render_peak = spent;
+    }
+}
+
+
+void on_midi_note_on(char chan, char key, char vel) {
+    // Instruments sometimes send "note off" messages as note on messages
+    // with a velocity of zero. Check here for that condition and delegate
+    // to the handler for note off.
+    if (vel == 0) {
+        on_midi_note_off(chan, key, vel);
+        return;
+    }
+    
+    // Light LED for midi note on
+    HAL_LED_NOTE(1);
+    
+    // Given the MIDI note, which pitch should we be playing in the selected
+    // tuning?
+    const tuning_t* tuning = tuning_current();
+    const unsigned char index = key & 0x7f;
+    
+    // In poly mode the key gets a voice, and only that voice's oscillator
+    // starts (or restarts, if the voice was stolen.)
+    if (g_voice_mode == VOICE_MODE_POLY) {
+        const unsigned char v = voice_note_on(&g_voices, index, vel & 0x7f);
+        g_voice_pitch[v] = tuning->pitch[index];
+        g_voice_divisor[v] = tuning->divisor[index];
+        set_oscillator_divisor(v,
+                               oscillator_divisor(v, g_pitch_bend +
+                                                     g_pitch_mod), 1);
+        note_written();
+        env_gate_on(&g_env);
+        return;
+    }
+    
+    // In unison mode the key joins those held, and plays if it has
+    // priority: legato if a note was sounding (and not releasing), or from
+    // the start. A key struck again restarts its note when legato is off.
+    note_stack_push(&g_notes, index);
+    const unsigned char next = note_stack_current(&g_notes);
+    const unsigned char sounding =
+        (g_note_on_key != NOTE_NONE) && !g_releasing;
+    if (next != g_note_on_key || !sounding ||
+        (next == index && !g_legato)) {
+        play_note(next, sounding && g_legato);
+        note_written();
+    }
+}
+
+// Configure I/O pins used in the system, set them to their initial state.
+status_t iopins_init() {
+    HAL_GPIO_INIT();
+    
+    //for (int i = 0; i < 20; ++i) {
+    //    PORTDbits.RD1 = 1;
+    //    __delay_ms(100);
+    //}
+    //PORTDbits.RD1 = 0;
+    
+    return 0;
+}
+
+
+void on_pitch_bend(char chan, char lsb, char msb) {
+    lsb &= 0x7f;
+    msb &= 0x7f;
+    long pitch_bend = msb;
+    pitch_bend <<= 7;
+    pitch_bend |= lsb;
+    g_pitch_bend = calc_pitch_bend(pitch_bend);
+    
+    // The oscillators follow on the next tick.
+    g_pitch_changed = 1;
+}
+
+
+// Portamento time (CC 5) runs from none to about two seconds, on a square
+// law for finer control of short times. In rate mode it is the time taken
+// to glide an octave.
+#define CC_MOD_WHEEL       1
+#define CC_PORTAMENTO_TIME 5
+#define CC_PORTAMENTO      65
+#define CC_LEGATO          68
+
+// Sound controllers: envelope times, on the same square law as portamento
+// time, and vibrato rate, on a square law up to LFO_RATE_MAX.
+#define CC_RELEASE_TIME    72
+#define CC_ATTACK_TIME     73
+#define CC_DECAY_TIME      75
+#define CC_VIBRATO_RATE    76
+#define LFO_RATE_MAX       ((uint16_t) (20UL * 65536 / TICK_HZ))    // 20 Hz
+
+// Square law from a controller value to ticks, up to about two seconds.
+#define CC_TIME(value) ((uint16_t) ((uint32_t) (value) * (value) * TICK_HZ / \
+                                    8000))
+
+// Channel mode messages: all sound off silences at once, and all notes off
+// releases the notes as if their keys were up; mono (unison) and poly mode
+// each also turn all notes off.
+#define CC_ALL_SOUND_OFF   120
+#define CC_ALL_NOTES_OFF   123
+#define CC_MONO_MODE_ON    126
+#define CC_POLY_MODE_ON    127
+
+void on_control_change(char chan, char controller, char value) {
+    value &= 0x7f;
+    switch (controller & 0x7f) {
+        case CC_MOD_WHEEL:
+            g_vibrato_depth = value;
+            break;
+        case CC_PORTAMENTO_TIME:
+            glide_set_time(&g_glide, g_glide.mode, CC_TIME(value));
+            break;
+        case CC_ATTACK_TIME:
+            set_envelope(CC_TIME(value), g_env_decay, g_env_sustain,
+                         g_env_release);
+            break;
+        case CC_DECAY_TIME:
+            set_envelope(g_env_attack, CC_TIME(value), g_env_sustain,
+                         g_env_release);
+            break;
+        case CC_RELEASE_TIME:
+            set_envelope(g_env_attack, g_env_decay, g_env_sustain,
+                         CC_TIME(value));
+            break;
+        case CC_VIBRATO_RATE:
+            set_lfo(g_lfo.shape, (uint16_t) ((uint32_t) value * value *
+                                             LFO_RATE_MAX / (127 * 127)));
+            break;
+        case CC_PORTAMENTO:
+            g_portamento = (value >= 64);
+            break;
+        case CC_LEGATO:
+            g_legato = (value >= 64);
+            break;
+        case CC_ALL_SOUND_OFF:
+            all_notes_off();
+            break;
+        case CC_ALL_NOTES_OFF:
+            release_all_notes();
+            break;
+        case CC_MONO_MODE_ON:
+            set_voice_mode(VOICE_MODE_UNISON, g_voices.steal);
+            break;
+        case CC_POLY_MODE_ON:
+            set_voice_mode(VOICE_MODE_POLY, g_voices.steal);
+            break;
+    }
+}
+
+
+void on_program_change(char chan, char program, char unused) {
+    // Programs select among the resident tunings, from the next note on.
+    // Programs beyond the last tuning are ignored.
+    tuning_select(program & 0x7f);
+}
+
+/*
+ * Main loop tasks, run by the scheduler (see sched.h) in priority order:
+ * MIDI first, so that a note waits at most for one run of any of the
+ * others. The modulators and the DAC are driven by the tick interrupt
+ * itself (see synth_tick_isr().)
+ */
+
+// Dispatch the events that the receive interrupt has decoded, with their
+// arrival times, a contiguous run of the queue at a time; yield over
+// budget, between events, handing back the rest of the run.
+static unsigned char task_midi(void) {
+    const midi_event_t* events = 0;
+    const uint16_t* times = 0;
+    unsigned char count = 0;
+    while ((count = eventq_peek(&events, &times)) != 0) {
+        for (unsigned char i = 0; i < count; ++i) {
+            if (sched_over_budget()) {
+                eventq_consume(i);
+                return 1;
+            }
+            midi_dispatch(&events[i], times[i]);
+        }
+        eventq_consume(count);
+    }
+    return 0;
+}
+
+// The input has gone quiet with active sensing on: silence every note,
+// and expect active sensing no longer.
+static unsigned char sensing_lost(void) {
+    return g_sensing_lost;
+}
+
+static unsigned char task_watchdog(void) {
+    g_sensing_lost = 0;
+    g_sensing = 0;
+    all_notes_off();
+    return 0;
+}
+
+// Once a tick: vibrato from the LFO, and the end of a release in unison
+// mode, which plays until the envelope has finished. Before the pitch
+// update, which applies the vibrato.
+static unsigned char task_modulation(void) {
+    set_pitch_modulation((g_lfo_out * g_vibrato_depth) >> VIBRATO_SHIFT);
+    if (g_releasing && env_idle(&g_env)) {
+        all_notes_off();
+    }
+    return 0;
+}
+
+// Once a tick: advance the glide by the ticks that have elapsed since the
+// last run, however late that was, so that it runs at the tick rate. Only
+// the counters whose divisor changes are written.
+static unsigned char task_pitch(void) {
+    const unsigned char ticks = sched_ticks();
+    g_pitch_changed |= glide_advance(&g_glide, ticks - g_ticks_seen);
+    g_ticks_seen = ticks;
+    if ((g_note_on_key != NOTE_NONE || g_voices.playing) &&
+        g_pitch_changed) {
+        update_oscillators(0);
+    }
+    return 0;
+}
+
+// Once a tick: at most one command or character for the LCD, which is
+// never waited on.
+static unsigned char task_display(void) {
+    display_service();
+    return 0;
+}
+
+static sched_task_t g_tasks[] = {
+    { "midi", task_midi, eventq_available, 0, 0, SCHED_TCY(2000) },
+    { "watchdog", task_watchdog, sensing_lost, 0, 0, SCHED_TCY(2000) },
+    { "modulation", task_modulation, 0, 1, 1, SCHED_TCY(200) },
+    { "pitch", task_pitch, 0, 1, 1, SCHED_TCY(2000) },
+    { "display", task_display, 0, 1, 4, SCHED_TCY(200) }
+};
+
+
+// Perform initial system initialization.
+status_t system_init() {
+    status_t status = 0;
+    
+    // Configure and initialize I/O pins used in the system.
+    status = iopins_init();
+    if (status) {
+        return status;
+    }
+    
+    // Start the clock that the receive interrupt stamps bytes with.
+    clock_init();
+    
+    // Initialize the USART for receive / transmit, and the queue that the
+    // receive interrupt decodes MIDI into.
+    status = ioport_init(MIDI_BAUD_RATE);
+    if (status) {
+        return status;
+    }
+    eventq_init();
+    
+    // Initialize the Intel 8254 Timer 
+    status = intel_8254_init();
+    if (status) {
+        return status;
+    }
+    
+    // Start with no notes on, and the settings as a MIDI reset leaves them
+    // (see default_settings().)
+    note_stack_init(&g_notes, NOTE_PRIORITY_LAST);
+    g_note_on_key = NOTE_NONE;
+    g_releasing = 0;
+    voice_init(&g_voices, INTEL8254_COUNTERS, VOICE_STEAL_OLDEST);
+    glide_init(&g_glide);
+    default_settings();
+    
+    // The envelope is a plain gate until set; the LFO runs at 5 Hz.
+    g_env_attack = 0;
+    g_env_decay = 0;
+    g_env_sustain = ENV_LEVEL_MAX;
+    g_env_release = 0;
+    env_init(&g_env);
+    lfo_init(&g_lfo);
+    lfo_set(&g_lfo, LFO_SINE, LFO_DEFAULT_RATE);
+    g_render_peak = 0;
+    g_sensing_lost = 0;
+    g_quiet_ticks = 0;
+    g_note_latency = 0;
+    g_note_latency_peak = 0;
+    
+    // Initialize MIDI library.
+    status = midi_init();
+    if (status) {
+        return status;
+    }
+    
+    status = midi_register_event_handler(EVT_SYS_REALTIME_ACTIVE_SENSE,
+                                         on_midi_active_sensing);
+
+    status = midi_register_event_handler(EVT_SYS_REALTIME_RESET,
+                                         on_midi_reset);
+
+    status = midi_register_event_handler(EVT_CHAN_NOTE_OFF,
+                                         on_midi_note_off);
+
+    status = midi_register_event_handler(EVT_CHAN_NOTE_ON,
+                                         on_midi_note_on);
+    
+    status = midi_register_event_handler(EVT_CHAN_PITCH_BEND,
+                                         on_pitch_bend);
+    
+    status = midi_register_event_handler(EVT_CHAN_PROGRAM_CHANGE,
+                                         on_program_change);
+    
+    status = midi_register_event_handler(EVT_CHAN_CONTROL_CHANGE,
+                                         on_control_change);
+    
+    // TODO(tdial): Eliminate
+    on_midi_note_off(0, 0, 0);
+    
+    if (status) {
+        return status;
+    }
+    
+    // The DAC must be ready before the first tick renders to it.
+    status = dac_init();
+    if (status) {
+        return status;
+    }
+    
+    // The main loop's tasks, paced by the control tick, which also renders
+    // modulation.
+    sched_init(g_tasks, sizeof(g_tasks) / sizeof(g_tasks[0]));
+    g_ticks_seen = sched_ticks();
+    HAL_TICK_OPEN();
+    
+    // Handlers are in place; let the receive interrupt start filling the
+    // event queue.
+    HAL_IRQ_ENABLE();
+    
+    return 0;
+}
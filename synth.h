@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * The synthesizer application: MIDI event handlers, oscillator control and
+ * the main loop's tasks, which system_init() gives the scheduler (see
+ * sched.h.)
+ */
+#ifndef SYNTH_H_INCLUDED_
+#define SYNTH_H_INCLUDED_
+
+#include <stdint.h>
+#include "glide.h"
+#include "modulation.h"
+#include "note_stack.h"
+#include "status.h"
+#include "voice.h"
+
+// Perform initial system initialization.
+status_t system_init();
+
+// Set the pitch modulation (vibrato) offset, in pitch steps (see pitch.h),
+// applied to all oscillators from the next tick.
+void set_pitch_modulation(int offset);
+
+// Set the portamento mode (GLIDE_MODE_xxx) and time in ticks; see glide.h.
+// MIDI CC 5 sets the time in the current mode, and CC 65 turns portamento
+// on and off.
+void set_portamento(unsigned char mode, uint16_t ticks);
+
+// Set the envelope that drives the VCA (DAC channel 0): attack, decay and
+// release times in ticks and the sustain level (0 to ENV_LEVEL_MAX); see
+// modulation.h. MIDI CC 73, 75 and 72 set the attack, decay and release
+// times.
+void set_envelope(uint16_t attack, uint16_t decay, uint16_t sustain,
+                  uint16_t release);
+
+// Set the shape (LFO_xxx) and rate of the vibrato LFO; see modulation.h.
+// MIDI CC 76 sets the rate, and the mod wheel (CC 1) the depth.
+void set_lfo(unsigned char shape, uint16_t rate);
+
+// Return the longest time, in Tcy, from a control tick to the end of the
+// interrupt's work for it (16 Tcy resolution.)
+uint16_t synth_render_peak();
+
+// Return the time, in microseconds, from the arrival of the last note on
+// (when the receive interrupt took its last byte) to its 8254 write, or
+// with 'peak' nonzero the longest since system_init().
+uint16_t synth_note_latency(unsigned char peak);
+
+// Set the note priority in unison mode (NOTE_PRIORITY_xxx; see
+// note_stack.h), and whether a change of key while others are held is
+// played legato (carrying on the note, or gliding to the new pitch with
+// portamento on) or starts the note over. MIDI CC 68 turns legato on and
+// off.
+void set_note_priority(unsigned char priority, unsigned char legato);
+
+// Set the voice mode (VOICE_MODE_xxx) and, for poly mode, the voice
+// stealing policy (VOICE_STEAL_xxx); see voice.h. All notes are turned
+// off. MIDI CC 126 and 127 select unison and poly mode.
+void set_voice_mode(unsigned char mode, unsigned char steal);
+
+// Count a control tick and render the modulators; called from the timer
+// interrupt TICK_HZ times a second. The scheduler's tasks do the rest of
+// the work the ticks pace.
+void synth_tick_isr();
+
+// MIDI event handlers registered by system_init().
+void on_midi_active_sensing(char chan, char data1, char data2);
+void on_midi_reset(char chan, char data1, char data2);
+void on_midi_note_off(char chan, char key, char val);
+void on_midi_note_on(char chan, char key, char vel);
+void on_pitch_bend(char chan, char lsb, char msb);
+void on_program_change(char chan, char program, char unused);
+void on_control_change(char chan, char controller, char value);
+
+#endif  // SYNTH_H_INCLUDED_
@@ -0,0 +1,24 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * Tuning tables: the pitch of each MIDI key.
+ */
+#include "tuning.h"
+
+// Index of the selected tuning in TUNINGS.
+static unsigned char g_tuning_index = 0;
+
+
+status_t tuning_select(unsigned char index) {
+    if (index >= TUNING_COUNT) {
+        return E_TUNING_BAD_INDEX;
+    }
+    g_tuning_index = index;
+    return 0;
+}
+
+
+const tuning_t* tuning_current() {
+    return TUNINGS[g_tuning_index];
+}
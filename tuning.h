@@ -0,0 +1,48 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ * 
+ * Tuning tables: the pitch of each MIDI key.
+ *
+ * Several tunings are resident in program memory (tuning_tables.c, which is
+ * generated from Scala scale and keyboard mapping files by
+ * host/scl2tuning.c.) Each holds, for every key, a pitch with sub-cent
+ * resolution and the exact 8254 divisor, so a note-on in any tuning is a
+ * pair of lookups. One tuning is selected at a time.
+ */
+#ifndef TUNING_H_INCLUDED_
+#define TUNING_H_INCLUDED_
+
+#include <stdint.h>
+#include "pitch.h"
+#include "status.h"
+
+typedef enum tuning_errors {
+    E_TUNING_BAD_INDEX = -1
+} tuning_error_t;
+
+typedef struct tuning {
+    const char* name;        // Name of the scale file it was made from.
+    pitch_t pitch[128];      // Pitch of each key (see pitch.h.)
+    uint16_t divisor[128];   // Divisor of each key, from the exact frequency.
+} tuning_t;
+
+// The resident tunings (generated.)
+extern const tuning_t* const TUNINGS[];
+extern const unsigned char TUNING_COUNT;
+
+/**
+ * Select the tuning used for subsequent notes.
+ *
+ * @param index Index of the tuning in TUNINGS.
+ * @return Zero on success; E_TUNING_BAD_INDEX if there is no such tuning.
+ */
+status_t tuning_select(unsigned char index);
+
+/**
+ * Return the selected tuning (the first resident tuning until another is
+ * selected.)
+ */
+const tuning_t* tuning_current();
+
+#endif  // TUNING_H_INCLUDED_
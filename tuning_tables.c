@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Resident tuning tables for an 8254 clock of 2000000 Hz (see tuning.h.)
+ *
+ * GENERATED by host/scl2tuning.c from the Scala files noted below; do not
+ * edit.
+ */
+#include "tuning.h"
+
+// 12-tone equal temperament
+// (tunings/12tet.scl)
+static const tuning_t TUNING_12TET = {
+    "12TET",
+    {
+            0,   256,   512,   768,  1024,  1280,  1536,  1792,
+         2048,  2304,  2560,  2816,  3072,  3328,  3584,  3840,
+         4096,  4352,  4608,  4864,  5120,  5376,  5632,  5888,
+         6144,  6400,  6656,  6912,  7168,  7424,  7680,  7936,
+         8192,  8448,  8704,  8960,  9216,  9472,  9728,  9984,
+        10240, 10496, 10752, 11008, 11264, 11520, 11776, 12032,
+        12288, 12544, 12800, 13056, 13312, 13568, 13824, 14080,
+        14336, 14592, 14848, 15104, 15360, 15616, 15872, 16128,
+        16384, 16640, 16896, 17152, 17408, 17664, 17920, 18176,
+        18432, 18688, 18944, 19200, 19456, 19712, 19968, 20224,
+        20480, 20736, 20992, 21248, 21504, 21760, 22016, 22272,
+        22528, 22784, 23040, 23296, 23552, 23808, 24064, 24320,
+        24576, 24832, 25088, 25344, 25600, 25856, 26112, 26368,
+        26624, 26880, 27136, 27392, 27648, 27904, 28160, 28416,
+        28672, 28928, 29184, 29440, 29696, 29952, 30208, 30464,
+        30720, 30976, 31232, 31488, 31744, 32000, 32256, 32512
+    },
+    {
+        65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+        65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+        65535, 65535, 65535, 65535, 65535, 65535, 65535, 64793,
+        61156, 57724, 54484, 51426, 48540, 45815, 43244, 40817,
+        38526, 36364, 34323, 32396, 30578, 28862, 27242, 25713,
+        24270, 22908, 21622, 20408, 19263, 18182, 17161, 16198,
+        15289, 14431, 13621, 12856, 12135, 11454, 10811, 10204,
+         9631,  9091,  8581,  8099,  7645,  7215,  6810,  6428,
+         6067,  5727,  5405,  5102,  4816,  4545,  4290,  4050,
+         3822,  3608,  3405,  3214,  3034,  2863,  2703,  2551,
+         2408,  2273,  2145,  2025,  1911,  1804,  1703,  1607,
+         1517,  1432,  1351,  1276,  1204,  1136,  1073,  1012,
+          956,   902,   851,   804,   758,   716,   676,   638,
+          602,   568,   536,   506,   478,   451,   426,   402,
+          379,   358,   338,   319,   301,   284,   268,   253,
+          239,   225,   213,   201,   190,   179,   169,   159
+    }
+};
+
+// 5-limit just intonation (Ptolemy's intense diatonic, chromatic extension)
+// (tunings/just.scl:tunings/just.kbm)
+static const tuning_t TUNING_JUST = {
+    "JUST",
+    {
+            0,   286,   522,   808,   989,  1275,  1511,  1797,
+         2083,  2264,  2605,  2786,  3072,  3358,  3594,  3880,
+         4061,  4347,  4583,  4869,  5155,  5336,  5677,  5858,
+         6144,  6430,  6666,  6952,  7133,  7419,  7655,  7941,
+         8227,  8408,  8749,  8930,  9216,  9502,  9738, 10024,
+        10205, 10491, 10727, 11013, 11299, 11480, 11821, 12002,
+        12288, 12574, 12810, 13096, 13277, 13563, 13799, 14085,
+        14371, 14552, 14893, 15074, 15360, 15646, 15882, 16168,
+        16349, 16635, 16871, 17157, 17443, 17624, 17965, 18146,
+        18432, 18718, 18954, 19240, 19421, 19707, 19943, 20229,
+        20515, 20696, 21037, 21218, 21504, 21790, 22026, 22312,
+        22493, 22779, 23015, 23301, 23587, 23768, 24109, 24290,
+        24576, 24862, 25098, 25384, 25565, 25851, 26087, 26373,
+        26659, 26840, 27181, 27362, 27648, 27934, 28170, 28456,
+        28637, 28923, 29159, 29445, 29731, 29912, 30253, 30434,
+        30720, 31006, 31242, 31528, 31709, 31995, 32231, 32517
+    },
+    {
+        65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+        65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+        65535, 65535, 65535, 65535, 65535, 65535, 65535, 65233,
+        61156, 57334, 54361, 50963, 48925, 45867, 43489, 40771,
+        38223, 36694, 33976, 32617, 30578, 28667, 27180, 25482,
+        24462, 22934, 21744, 20385, 19111, 18347, 16988, 16308,
+        15289, 14333, 13590, 12741, 12231, 11467, 10872, 10193,
+         9556,  9173,  8494,  8154,  7645,  7167,  6795,  6370,
+         6116,  5733,  5436,  5096,  4778,  4587,  4247,  4077,
+         3822,  3583,  3398,  3185,  3058,  2867,  2718,  2548,
+         2389,  2293,  2123,  2039,  1911,  1792,  1699,  1593,
+         1529,  1433,  1359,  1274,  1194,  1147,  1062,  1019,
+          956,   896,   849,   796,   764,   717,   680,   637,
+          597,   573,   531,   510,   478,   448,   425,   398,
+          382,   358,   340,   319,   299,   287,   265,   255,
+          239,   224,   212,   199,   191,   179,   170,   159
+    }
+};
+
+// 19-tone equal temperament
+// (tunings/19edo.scl)
+static const tuning_t TUNING_19EDO = {
+    "19EDO",
+    {
+         6508,  6669,  6831,  6993,  7155,  7316,  7478,  7640,
+         7801,  7963,  8125,  8286,  8448,  8610,  8771,  8933,
+         9095,  9256,  9418,  9580,  9741,  9903, 10065, 10227,
+        10388, 10550, 10712, 10873, 11035, 11197, 11358, 11520,
+        11682, 11843, 12005, 12167, 12328, 12490, 12652, 12813,
+        12975, 13137, 13299, 13460, 13622, 13784, 13945, 14107,
+        14269, 14430, 14592, 14754, 14915, 15077, 15239, 15400,
+        15562, 15724, 15885, 16047, 16209, 16371, 16532, 16694,
+        16856, 17017, 17179, 17341, 17502, 17664, 17826, 17987,
+        18149, 18311, 18472, 18634, 18796, 18957, 19119, 19281,
+        19443, 19604, 19766, 19928, 20089, 20251, 20413, 20574,
+        20736, 20898, 21059, 21221, 21383, 21544, 21706, 21868,
+        22029, 22191, 22353, 22515, 22676, 22838, 23000, 23161,
+        23323, 23485, 23646, 23808, 23970, 24131, 24293, 24455,
+        24616, 24778, 24940, 25101, 25263, 25425, 25587, 25748,
+        25910, 26072, 26233, 26395, 26557, 26718, 26880, 27042
+    },
+    {
+        56337, 54319, 52373, 50496, 48687, 46943, 45262, 43640,
+        42077, 40569, 39116, 37715, 36364, 35061, 33805, 32594,
+        31426, 30300, 29215, 28168, 27159, 26186, 25248, 24344,
+        23472, 22631, 21820, 21038, 20285, 19558, 18857, 18182,
+        17530, 16902, 16297, 15713, 15150, 14607, 14084, 13580,
+        13093, 12624, 12172, 11736, 11315, 10910, 10519, 10142,
+         9779,  9429,  9091,  8765,  8451,  8148,  7857,  7575,
+         7304,  7042,  6790,  6547,  6312,  6086,  5868,  5658,
+         5455,  5260,  5071,  4890,  4714,  4545,  4383,  4226,
+         4074,  3928,  3788,  3652,  3521,  3395,  3273,  3156,
+         3043,  2934,  2829,  2728,  2630,  2536,  2445,  2357,
+         2273,  2191,  2113,  2037,  1964,  1894,  1826,  1761,
+         1697,  1637,  1578,  1521,  1467,  1414,  1364,  1315,
+         1268,  1222,  1179,  1136,  1096,  1056,  1019,   982,
+          947,   913,   880,   849,   818,   789,   761,   733,
+          707,   682,   657,   634,   611,   589,   568,   548
+    }
+};
+
+const tuning_t* const TUNINGS[] = {
+    &TUNING_12TET,
+    &TUNING_JUST,
+    &TUNING_19EDO
+};
+
+const unsigned char TUNING_COUNT = 3;
@@ -0,0 +1,129 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Voice allocation with a key map, a free queue and oldest or quietest
+ * stealing.
+ */
+#include "voice.h"
+
+
+// Take a voice off the playing list.
+static void unlink_playing(voice_alloc_t* alloc, unsigned char v) {
+    voice_t* const voice = &alloc->voice[v];
+    if (voice->older == VOICE_NONE) {
+        alloc->oldest = voice->newer;
+    } else {
+        alloc->voice[voice->older].newer = voice->newer;
+    }
+    if (voice->newer == VOICE_NONE) {
+        alloc->newest = voice->older;
+    } else {
+        alloc->voice[voice->newer].older = voice->older;
+    }
+}
+
+// Put a voice at the new end of the playing list.
+static void link_newest(voice_alloc_t* alloc, unsigned char v) {
+    voice_t* const voice = &alloc->voice[v];
+    voice->older = alloc->newest;
+    voice->newer = VOICE_NONE;
+    if (alloc->newest == VOICE_NONE) {
+        alloc->oldest = v;
+    } else {
+        alloc->voice[alloc->newest].newer = v;
+    }
+    alloc->newest = v;
+}
+
+// Put a voice at the end of the free queue.
+static void queue_free(voice_alloc_t* alloc, unsigned char v) {
+    alloc->voice[v].key = VOICE_NO_KEY;
+    alloc->voice[v].newer = VOICE_NONE;
+    if (alloc->free_last == VOICE_NONE) {
+        alloc->free_first = v;
+    } else {
+        alloc->voice[alloc->free_last].newer = v;
+    }
+    alloc->free_last = v;
+}
+
+// Choose a playing voice to take for a new note.
+static unsigned char choose_victim(const voice_alloc_t* alloc) {
+    unsigned char victim = alloc->oldest;
+    if (alloc->steal == VOICE_STEAL_QUIETEST) {
+        for (unsigned char v = alloc->voice[victim].newer; v != VOICE_NONE;
+             v = alloc->voice[v].newer) {
+            if (alloc->voice[v].velocity < alloc->voice[victim].velocity) {
+                victim = v;
+            }
+        }
+    }
+    return victim;
+}
+
+
+void voice_init(voice_alloc_t* alloc, unsigned char count,
+                unsigned char steal) {
+    if (count == 0 || count > VOICE_MAX) {
+        count = VOICE_MAX;
+    }
+    for (unsigned char key = 0; key < 128; ++key) {
+        alloc->key_voice[key] = VOICE_NONE;
+    }
+    alloc->count = count;
+    alloc->playing = 0;
+    alloc->oldest = VOICE_NONE;
+    alloc->newest = VOICE_NONE;
+    alloc->free_first = VOICE_NONE;
+    alloc->free_last = VOICE_NONE;
+    alloc->steal = steal;
+    for (unsigned char v = 0; v < count; ++v) {
+        alloc->voice[v].velocity = 0;
+        alloc->voice[v].older = VOICE_NONE;
+        queue_free(alloc, v);
+    }
+}
+
+
+unsigned char voice_note_on(voice_alloc_t* alloc, unsigned char key,
+                            unsigned char velocity) {
+    key &= 0x7f;
+
+    // A key played again keeps its voice.
+    unsigned char v = alloc->key_voice[key];
+    if (v != VOICE_NONE) {
+        unlink_playing(alloc, v);
+    } else if (alloc->free_first != VOICE_NONE) {
+        v = alloc->free_first;
+        alloc->free_first = alloc->voice[v].newer;
+        if (alloc->free_first == VOICE_NONE) {
+            alloc->free_last = VOICE_NONE;
+        }
+        ++alloc->playing;
+    } else {
+        v = choose_victim(alloc);
+        unlink_playing(alloc, v);
+        alloc->key_voice[alloc->voice[v].key] = VOICE_NONE;
+    }
+
+    alloc->voice[v].key = key;
+    alloc->voice[v].velocity = velocity;
+    alloc->key_voice[key] = v;
+    link_newest(alloc, v);
+    return v;
+}
+
+
+unsigned char voice_note_off(voice_alloc_t* alloc, unsigned char key) {
+    key &= 0x7f;
+    const unsigned char v = alloc->key_voice[key];
+    if (v == VOICE_NONE) {
+        return VOICE_NONE;
+    }
+    alloc->key_voice[key] = VOICE_NONE;
+    unlink_playing(alloc, v);
+    queue_free(alloc, v);
+    --alloc->playing;
+    return v;
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2018 Thomas R. Dial
+ * All Rights Reserved
+ *
+ * Voice allocation: which key each voice is playing. A voice is whatever
+ * the synth plays a note with; in poly mode, one 8254 counter.
+ *
+ * Every operation takes constant time: a map from each of the 128 keys to
+ * its voice finds a key's voice, free voices are kept in a queue and the
+ * voices playing in a list, oldest first. When every voice is playing, a
+ * new note takes one of them:
+ *
+ *   VOICE_STEAL_OLDEST    - The voice that started playing first.
+ *   VOICE_STEAL_QUIETEST  - The voice with the lowest velocity, or of
+ *                           those, the oldest. This looks at each voice
+ *                           playing, so it is bounded by VOICE_MAX.
+ */
+#ifndef VOICE_H_INCLUDED_
+#define VOICE_H_INCLUDED_
+
+// Most voices an allocator manages: one per counter on a full bus of
+// 8254s.
+#define VOICE_MAX 12
+
+// Returned, and held in the map, where there is no voice.
+#define VOICE_NONE 0xff
+
+// Held by a voice that is not playing a key.
+#define VOICE_NO_KEY 0xff
+
+typedef enum voice_steal {
+    VOICE_STEAL_OLDEST = 0,
+    VOICE_STEAL_QUIETEST = 1
+} voice_steal_t;
+
+// How the synth plays voices on the counters: every counter on one note,
+// detuned, or a voice per counter.
+typedef enum voice_mode {
+    VOICE_MODE_UNISON = 0,
+    VOICE_MODE_POLY = 1
+} voice_mode_t;
+
+typedef struct voice {
+    unsigned char key;          // Key playing, or VOICE_NO_KEY.
+    unsigned char velocity;     // Velocity it was played at.
+    unsigned char older;        // Links: the playing list, or the free
+    unsigned char newer;        // queue (newer only.)
+} voice_t;
+
+typedef struct voice_alloc {
+    unsigned char key_voice[128];   // Voice playing each key, or VOICE_NONE.
+    voice_t voice[VOICE_MAX];
+    unsigned char count;            // Voices managed.
+    unsigned char playing;          // Voices playing a key.
+    unsigned char oldest;           // Ends of the playing list.
+    unsigned char newest;
+    unsigned char free_first;       // Ends of the free queue.
+    unsigned char free_last;
+    unsigned char steal;            // VOICE_STEAL_xxx
+} voice_alloc_t;
+
+/**
+ * Initialize an allocator with every voice free.
+ *
+ * @param alloc Allocator to initialize.
+ * @param count Voices to manage, 1 to VOICE_MAX.
+ * @param steal VOICE_STEAL_xxx policy for when every voice is playing.
+ */
+void voice_init(voice_alloc_t* alloc, unsigned char count,
+                unsigned char steal);
+
+/**
+ * Allocate a voice to a key. A key that is already playing keeps its voice,
+ * which becomes the newest. Otherwise the voice that has been free longest
+ * is taken, or if there is none, one is stolen from the key it was playing.
+ *
+ * @param alloc Allocator.
+ * @param key MIDI key, 0 to 127.
+ * @param velocity Velocity of the note.
+ * @return The voice.
+ */
+unsigned char voice_note_on(voice_alloc_t* alloc, unsigned char key,
+                            unsigned char velocity);
+
+/**
+ * Release the voice playing a key.
+ *
+ * @return The voice released, or VOICE_NONE if the key was not playing
+ *         (it was never allocated, or its voice was stolen.)
+ */
+unsigned char voice_note_off(voice_alloc_t* alloc, unsigned char key);
+
+// Return the voice playing a key, or VOICE_NONE.
+#define voice_of_key(alloc, key) ((alloc)->key_voice[(key) & 0x7f])
+
+// Return the key a voice is playing, or VOICE_NO_KEY.
+#define voice_key(alloc, v) ((alloc)->voice[(v)].key)
+
+#endif  // VOICE_H_INCLUDED_